@@ -14,15 +14,15 @@ struct BiquadDemoParams {
     enum class ID { Gain, Frequency, Q, Response };
 
     // Create parameter definitions
-    inline jnsc::juce_interface::ParameterSet<ID> createParams() {
+    static constexpr jnsc::juce_interface::ParameterSet<ID> createParams() {
         using namespace jnsc::juce_interface;
 
         ParameterSet<ID> params;
         // clang-format off
-        // Float parameter        ↓ id          ↓ name      ↓ min   ↓ max     ↓ def     ↓ unit  ↓ skew
-        params.add(FloatParam<ID>{ID::Gain, "Gain", -20.0f, 20.0f, 0.0f, "dB", 1.0f});
-        params.add(FloatParam<ID>{ID::Frequency, "Frequency", 10.0f, 20000.0f, 1000.0f, "Hz", 0.5f});
-        params.add(FloatParam<ID>{ID::Q, "Q", 0.1f, 10.0f, 0.707f, "", 1.0f});
+        // Float parameter        ↓ id          ↓ name      ↓ min   ↓ max     ↓ def     ↓ unit  ↓ skew  ↓ smoothing (ms, curve)
+        params.add(FloatParam<ID>{ID::Gain, "Gain", -20.0f, 20.0f, 0.0f, "dB", 1.0f, 20.0f});
+        params.add(FloatParam<ID>{ID::Frequency, "Frequency", 10.0f, 20000.0f, 1000.0f, "Hz", 0.5f, 20.0f, SmoothingCurve::Multiplicative});
+        params.add(FloatParam<ID>{ID::Q, "Q", 0.1f, 10.0f, 0.707f, "", 1.0f, 20.0f, SmoothingCurve::Multiplicative});
 
         // Choice parameter        ↓ id            ↓ name     ↓ choices            ↓ def idx
         params.add(ChoiceParam<ID>{ID::Response, "Response", {"Low Pass",
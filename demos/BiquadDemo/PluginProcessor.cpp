@@ -2,9 +2,11 @@
 #include "PluginEditor.h"
 #include <JuceHeader.h>
 #include <iostream>
-#include <jonssonic/utils/buffer_utils.h>
 
-BiquadDemoAudioProcessor::BiquadDemoAudioProcessor() : parameterManager(BiquadDemoParams().createParams(), *this) {
+// Parameter definitions, evaluated at compile time (no heap allocation)
+static constexpr auto parameters = BiquadDemoParams::createParams();
+
+BiquadDemoAudioProcessor::BiquadDemoAudioProcessor() : parameterManager(parameters, *this) {
     // ============================================================================
     // [DEBUG]: Prints all APVTS parameter IDs at startup
     // This helps verify that your parameters are registered correctly.
@@ -24,17 +26,14 @@ BiquadDemoAudioProcessor::BiquadDemoAudioProcessor() : parameterManager(BiquadDe
 
     parameterManager.on(ID::Gain, [this](float value, bool skipSmoothing) {
         biquad.setGain(jnsc::Gain<float>::Decibels(value));
-        DBG("[DEBUG] Gain changed: " + juce::String(value));
     });
 
     parameterManager.on(ID::Frequency, [this](float value, bool skipSmoothing) {
         biquad.setFrequency(jnsc::Frequency<float>::Hertz(value));
-        DBG("[DEBUG] Frequency changed: " + juce::String(value) + " Hz");
     });
 
     parameterManager.on(ID::Q, [this](float value, bool skipSmoothing) {
         biquad.setQ(value);
-        DBG("[DEBUG] Q changed: " + juce::String(value));
     });
 
     parameterManager.on(ID::Response, [this](int value, bool skipSmoothing) {
@@ -46,10 +45,18 @@ BiquadDemoAudioProcessor::BiquadDemoAudioProcessor() : parameterManager(BiquadDe
 BiquadDemoAudioProcessor::~BiquadDemoAudioProcessor() {}
 
 void BiquadDemoAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
-    auto numChannels = static_cast<size_t>(getTotalNumOutputChannels());
+    // Process in fixed internal blocks for consistent cache use with any host block size
+    parameterManager.setMaxSubBlockSize(internalBlockSize);
+
+    // Mono input into several outputs: the DSP runs on one channel and is copied to the others
+    channelFanOut.prepare(getTotalNumInputChannels(), getTotalNumOutputChannels());
+    auto numChannels = static_cast<size_t>(channelFanOut.getNumProcessChannels());
     // Prepare all DSP objects and buffers here
     biquad.prepare(numChannels, static_cast<float>(sampleRate));
 
+    // Prepare framework parameter smoothing (FloatParams with a smoothing time in Params.h)
+    parameterManager.prepare(sampleRate);
+
     // Initialize DSP with parameter defaults (defined in Params.h) (skip smoothing for instant setup)
     parameterManager.syncAll(true);
 }
@@ -68,24 +75,28 @@ void BiquadDemoAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, ju
     // Early return if no audio to process
     if (numInputChannels == 0 || numOutputChannels == 0 || numSamples == 0)
         return;
-    // Update all parameters from FIFO (GUI thread → Audio thread)
-    parameterManager.update();
 
     // Handle denormals
     juce::ScopedNoDenormals noDenormals;
 
-    // Note: Jonssonic DSP expects numInputChannels == numOutputChannels
-    // So we map the input channels to output channels accordingly
-    jnsc::utils::mapChannels<float>(buffer.getArrayOfReadPointers(),
-                                    buffer.getArrayOfWritePointers(),
-                                    numInputChannels,
-                                    numOutputChannels,
-                                    numSamples);
-
-    // Process audio with biquad filter
-    biquad.processBlock(buffer.getArrayOfReadPointers(),  // dry input
-                        buffer.getArrayOfWritePointers(), // output
-                        static_cast<size_t>(numSamples)); // number of samples
+    // Turn learned MIDI CCs into sample-accurate parameter events
+    parameterManager.processMidi(midiMessages);
+
+    // Process in sub-blocks split at timestamped parameter events (applies pending GUI/host changes first)
+    parameterManager.processSubBlocks(numSamples, [&](int startSample, int numSubSamples) {
+        // View into the host buffer for this sub-block (no copy, no allocation)
+        juce::AudioBuffer<float> block(
+            buffer.getArrayOfWritePointers(), buffer.getNumChannels(), startSample, numSubSamples);
+
+        // Note: Jonssonic DSP expects numInputChannels == numOutputChannels
+        // The fan-out maps the input channels to the output channels without copying
+        // Process audio with biquad filter (once for mono input, then copied to the other outputs)
+        channelFanOut.process(block.getArrayOfWritePointers(), numSubSamples, [&](float* const* channels, int, int n) {
+            biquad.processBlock(channels,                // input
+                                channels,                // output
+                                static_cast<size_t>(n)); // number of samples
+        });
+    });
 }
 
 void BiquadDemoAudioProcessor::getStateInformation(juce::MemoryBlock& destData) {
@@ -3,6 +3,7 @@
 #include <MinimalJuceHeader.h>
 #include <jonssonic/core/filters/biquad_filter.h>
 #include <parameters/ParameterManager.h>
+#include <utils/ChannelFanOut.h>
 
 class BiquadDemoAudioProcessor : public juce::AudioProcessor {
   public:
@@ -35,7 +36,11 @@ class BiquadDemoAudioProcessor : public juce::AudioProcessor {
     juce::AudioProcessorValueTreeState& getAPVTS() { return parameterManager.getAPVTS(); }
 
   private:
+    // Fixed internal block size (the DSP never sees longer blocks, whatever the host sends)
+    static constexpr int internalBlockSize = 64;
+
     jnsc::BiquadFilter<float> biquad;
+    jnsc::juce_interface::ChannelFanOut channelFanOut; // Processes mono input once
 
     // Parameter manager
     jnsc::juce_interface::ParameterManager<BiquadDemoParams::ID> parameterManager;
@@ -3,8 +3,10 @@
 #include <JuceHeader.h>
 #include <iostream>
 
-OversamplingDemoAudioProcessor::OversamplingDemoAudioProcessor()
-    : parameterManager(OversamplingDemoParams().createParams(), *this) {
+// Parameter definitions, evaluated at compile time (no heap allocation)
+static constexpr auto parameters = OversamplingDemoParams::createParams();
+
+OversamplingDemoAudioProcessor::OversamplingDemoAudioProcessor() : parameterManager(parameters, *this) {
     // ============================================================================
     // [DEBUG]: Prints all APVTS parameter IDs at startup
     // This helps verify that your parameters are registered correctly.
@@ -23,12 +25,10 @@ OversamplingDemoAudioProcessor::OversamplingDemoAudioProcessor()
 
     parameterManager.on(ID::Drive, [this](float value, bool skipSmoothing) {
         distortion.setInputGain(jnsc::Gain<float>::Decibels(value));
-        DBG("[DEBUG] Drive changed: " + juce::String(value) + " dB");
     });
 
     parameterManager.on(ID::OutputGain, [this](float value, bool skipSmoothing) {
         distortion.setOutputGain(jnsc::Gain<float>::Decibels(value));
-        DBG("[DEBUG] Output Gain changed: " + juce::String(value) + " dB");
     });
 
     // Map parameter index to actual oversampling factor
@@ -42,14 +42,20 @@ OversamplingDemoAudioProcessor::OversamplingDemoAudioProcessor()
 OversamplingDemoAudioProcessor::~OversamplingDemoAudioProcessor() {}
 
 void OversamplingDemoAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
+    // Process in fixed internal blocks for consistent cache use with any host block size
+    parameterManager.setMaxSubBlockSize(internalBlockSize);
+
     auto numChannels = static_cast<size_t>(getTotalNumOutputChannels());
 
     // Prepare oversampled processor wrapper
-    oversampledProcessor.prepare(numChannels, static_cast<size_t>(samplesPerBlock));
+    oversampledProcessor.prepare(numChannels, static_cast<size_t>(internalBlockSize));
 
     // Prepare distortion stage
     distortion.prepare(numChannels, static_cast<float>(sampleRate));
 
+    // Prepare framework parameter smoothing (FloatParams with a smoothing time in Params.h)
+    parameterManager.prepare(sampleRate);
+
     // Initialize DSP with parameter defaults (defined in Params.h) (skip smoothing for instant setup)
     parameterManager.syncAll(true);
 }
@@ -68,20 +74,27 @@ void OversamplingDemoAudioProcessor::processBlock(juce::AudioBuffer<float>& buff
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    // Update all parameters from FIFO (GUI thread → Audio thread)
-    parameterManager.update();
-
     // Handle denormals
     juce::ScopedNoDenormals noDenormals;
 
-    // Process with current oversampling factor
-    oversampledProcessor.processBlock(currentOversamplingFactor,
-                                      buffer.getArrayOfReadPointers(),
-                                      buffer.getArrayOfWritePointers(),
-                                      static_cast<size_t>(numSamples),
-                                      [this](const float* const* input, float* const* output, size_t samples) {
-                                          distortion.processBlock(input, output, samples);
-                                      });
+    // Turn learned MIDI CCs into sample-accurate parameter events
+    parameterManager.processMidi(midiMessages);
+
+    // Process in sub-blocks split at timestamped parameter events (applies pending GUI/host changes first)
+    parameterManager.processSubBlocks(numSamples, [&](int startSample, int numSubSamples) {
+        // View into the host buffer for this sub-block (no copy, no allocation)
+        juce::AudioBuffer<float> block(
+            buffer.getArrayOfWritePointers(), buffer.getNumChannels(), startSample, numSubSamples);
+
+        // Process with current oversampling factor
+        oversampledProcessor.processBlock(currentOversamplingFactor,
+                                          block.getArrayOfReadPointers(),
+                                          block.getArrayOfWritePointers(),
+                                          static_cast<size_t>(numSubSamples),
+                                          [this](const float* const* input, float* const* output, size_t samples) {
+                                              distortion.processBlock(input, output, samples);
+                                          });
+    });
 }
 
 void OversamplingDemoAudioProcessor::getStateInformation(juce::MemoryBlock& destData) {
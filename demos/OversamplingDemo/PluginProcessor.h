@@ -36,6 +36,9 @@ class OversamplingDemoAudioProcessor : public juce::AudioProcessor {
     juce::AudioProcessorValueTreeState& getAPVTS() { return parameterManager.getAPVTS(); }
 
   private:
+    // Fixed internal block size (the DSP never sees longer blocks, whatever the host sends)
+    static constexpr int internalBlockSize = 64;
+
     // DSP objects
     jnsc::OversampledProcessor<float> oversampledProcessor;
     jnsc::WaveShaperProcessor<float, jnsc::WaveShaperType::HardClip> distortion;
@@ -14,14 +14,14 @@ struct SVFDemoParams {
     enum class ID { Frequency, Q, Response };
 
     // Create parameter definitions
-    inline jnsc::juce_interface::ParameterSet<ID> createParams() {
+    static constexpr jnsc::juce_interface::ParameterSet<ID> createParams() {
         using namespace jnsc::juce_interface;
 
         ParameterSet<ID> params;
         // clang-format off
-        // Float parameter        ↓ id              ↓ name           ↓ min   ↓ max     ↓ def     ↓ unit  ↓ skew
-        params.add(FloatParam<ID>{ID::Frequency,    "Frequency",     20.0f,  20000.0f,   440.0f,    "Hz",    1.0f});
-        params.add(FloatParam<ID>{ID::Q,            "Q",             0.1f,   10.0f,   1.0f,    "",    1.0f});
+        // Float parameter        ↓ id              ↓ name           ↓ min   ↓ max     ↓ def     ↓ unit  ↓ skew  ↓ smoothing (ms, curve)
+        params.add(FloatParam<ID>{ID::Frequency,    "Frequency",     20.0f,  20000.0f,   440.0f,    "Hz",    1.0f,   20.0f,  SmoothingCurve::Multiplicative});
+        params.add(FloatParam<ID>{ID::Q,            "Q",             0.1f,   10.0f,   1.0f,    "",    1.0f,   20.0f,  SmoothingCurve::Multiplicative});
         // Choice parameter       ↓ id              ↓ name           ↓ choices
         params.add(ChoiceParam<ID>{ID::Response,     "Response",      {"Low Pass", "High Pass", "Band Pass" }, 0});
 
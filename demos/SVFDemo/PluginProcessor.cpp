@@ -1,9 +1,11 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include <iostream>
-#include <jonssonic/utils/buffer_utils.h>
 
-SVFDemoAudioProcessor::SVFDemoAudioProcessor() : parameterManager(SVFDemoParams().createParams(), *this) {
+// Parameter definitions, evaluated at compile time (no heap allocation)
+static constexpr auto parameters = SVFDemoParams::createParams();
+
+SVFDemoAudioProcessor::SVFDemoAudioProcessor() : parameterManager(parameters, *this) {
     // ============================================================================
     // [DEBUG]: Prints all APVTS parameter IDs at startup
     // This helps verify that your parameters are registered correctly.
@@ -41,10 +43,18 @@ SVFDemoAudioProcessor::SVFDemoAudioProcessor() : parameterManager(SVFDemoParams(
 SVFDemoAudioProcessor::~SVFDemoAudioProcessor() {}
 
 void SVFDemoAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
-    auto numChannels = static_cast<size_t>(getTotalNumOutputChannels());
+    // Process in fixed internal blocks for consistent cache use with any host block size
+    parameterManager.setMaxSubBlockSize(internalBlockSize);
+
+    // Mono input into several outputs: the DSP runs on one channel and is copied to the others
+    channelFanOut.prepare(getTotalNumInputChannels(), getTotalNumOutputChannels());
+    auto numChannels = static_cast<size_t>(channelFanOut.getNumProcessChannels());
     // Prepare all DSP objects and buffers here
     svf.prepare(numChannels, static_cast<float>(sampleRate));
 
+    // Prepare framework parameter smoothing (FloatParams with a smoothing time in Params.h)
+    parameterManager.prepare(sampleRate);
+
     // Initialize DSP with parameter defaults (defined in Params.h) (skip smoothing for instant setup)
     parameterManager.syncAll(true);
 }
@@ -63,24 +73,26 @@ void SVFDemoAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     // Early return if no audio to process
     if (numInputChannels == 0 || numOutputChannels == 0 || numSamples == 0)
         return;
-    // Update all parameters from FIFO (GUI thread → Audio thread)
-    parameterManager.update();
 
     // Handle denormals
     juce::ScopedNoDenormals noDenormals;
 
-    // Note: Jonssonic DSP expects numInputChannels == numOutputChannels
-    // So we map the input channels to output channels accordingly
-    jnsc::utils::mapChannels<float>(buffer.getArrayOfReadPointers(),
-                                    buffer.getArrayOfWritePointers(),
-                                    numInputChannels,
-                                    numOutputChannels,
-                                    numSamples);
-
-    // Process the audio through the state variable filter
-    svf.processBlock(buffer.getArrayOfReadPointers(),
-                     buffer.getArrayOfWritePointers(),
-                     static_cast<size_t>(numSamples));
+    // Turn learned MIDI CCs into sample-accurate parameter events
+    parameterManager.processMidi(midiMessages);
+
+    // Process in sub-blocks split at timestamped parameter events (applies pending GUI/host changes first)
+    parameterManager.processSubBlocks(numSamples, [&](int startSample, int numSubSamples) {
+        // View into the host buffer for this sub-block (no copy, no allocation)
+        juce::AudioBuffer<float> block(
+            buffer.getArrayOfWritePointers(), buffer.getNumChannels(), startSample, numSubSamples);
+
+        // Note: Jonssonic DSP expects numInputChannels == numOutputChannels
+        // The fan-out maps the input channels to the output channels without copying
+        // Process the audio through the state variable filter (once for mono input, then copied to the other outputs)
+        channelFanOut.process(block.getArrayOfWritePointers(), numSubSamples, [&](float* const* channels, int, int n) {
+            svf.processBlock(channels, channels, static_cast<size_t>(n));
+        });
+    });
 }
 
 void SVFDemoAudioProcessor::getStateInformation(juce::MemoryBlock& destData) {
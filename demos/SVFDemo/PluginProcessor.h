@@ -4,6 +4,7 @@
 #include <MinimalJuceHeader.h>
 #include <jonssonic/core/filters/state_variable_filter.h>
 #include <parameters/ParameterManager.h>
+#include <utils/ChannelFanOut.h>
 
 class SVFDemoAudioProcessor : public juce::AudioProcessor {
   public:
@@ -36,8 +37,12 @@ class SVFDemoAudioProcessor : public juce::AudioProcessor {
     juce::AudioProcessorValueTreeState& getAPVTS() { return parameterManager.getAPVTS(); }
 
   private:
+    // Fixed internal block size (the DSP never sees longer blocks, whatever the host sends)
+    static constexpr int internalBlockSize = 64;
+
     // DSP objects and buffers
     jnsc::StateVariableFilter<float> svf;
+    jnsc::juce_interface::ChannelFanOut channelFanOut; // Processes mono input once
 
     // Parameter manager
     jnsc::juce_interface::ParameterManager<SVFDemoParams::ID> parameterManager;
@@ -0,0 +1,165 @@
+// Jonssonic Plugin Framework
+// Automation player - replays captured parameter events in an offline harness
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "AutomationRecorder.h"
+#include <juce_core/juce_core.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Replays a capture written by AutomationRecorder, block by block
+ *
+ * Loads the whole capture into memory, then feeds each block's events back
+ * into a ParameterManager the way they originally arrived: untimestamped
+ * changes through the mailbox, timestamped ones as sub-block events. Running
+ * the processor with the recorded block sizes reproduces the session's
+ * parameter traffic exactly, e.g., to profile or regression-test CPU spikes
+ * under heavy automation.
+ *
+ * Example usage (offline harness, see tools/AutomationReplay):
+ * @code
+ *   AutomationPlayer player;
+ *   if (!player.load(captureFile))
+ *       return;
+ *
+ *   processor.prepareToPlay(player.getSampleRate(), player.getMaxBlockSize(512));
+ *   for (size_t block = 0; block < player.getNumBlocks(); ++block) {
+ *       const int numSamples = player.getBlockSize(block, 512);
+ *       buffer.setSize(numChannels, numSamples, false, false, true);
+ *       player.applyBlock(block, parameterManager);
+ *       processor.processBlock(buffer, midi);
+ *   }
+ * @endcode
+ */
+class AutomationPlayer {
+  public:
+    /// Captured parameter event
+    struct Event {
+        int index;        // Parameter table index
+        float value;      // Native value
+        int sampleOffset; // Offset in the block, or automation_format::untimestamped
+    };
+
+    /// Default constructor
+    AutomationPlayer() = default;
+
+    /**
+     * @brief Load a capture file
+     * @param file Capture written by AutomationRecorder
+     * @return False if the file is missing, not a capture, or of a newer format version
+     */
+    bool load(const juce::File& file) {
+        blocks.clear();
+        events.clear();
+
+        juce::MemoryBlock data;
+        if (!file.loadFileAsData(data) || data.getSize() < static_cast<size_t>(automation_format::headerSize))
+            return false;
+
+        juce::MemoryInputStream stream(data.getData(), data.getSize(), false);
+        if (stream.readInt() != automation_format::magic)
+            return false;
+        if (stream.readInt() > automation_format::formatVersion)
+            return false;
+        sampleRate = static_cast<double>(stream.readInt());
+
+        const auto numRecords = stream.getNumBytesRemaining() / automation_format::recordSize;
+        events.reserve(static_cast<size_t>(numRecords));
+        for (int64_t i = 0; i < numRecords; ++i) {
+            const auto block = static_cast<uint32_t>(stream.readInt());
+            const int sampleOffset = stream.readShort();
+            const int index = stream.readShort();
+            const float value = stream.readFloat();
+
+            if (index == automation_format::blockMarker) {
+                // Blocks lost to a full recorder FIFO come back empty
+                while (blocks.size() <= block)
+                    blocks.push_back({0, events.size(), 0});
+                blocks[block].numSamples = static_cast<int>(value);
+                continue;
+            }
+            if (static_cast<size_t>(block) + 1 != blocks.size())
+                continue; // The recorder dropped this block's marker
+
+            events.push_back({index, value, sampleOffset});
+            ++blocks.back().numEvents;
+        }
+        return true;
+    }
+
+    /// Get the sample rate of the recorded session
+    double getSampleRate() const { return sampleRate; }
+
+    /// Get the number of recorded blocks
+    size_t getNumBlocks() const { return blocks.size(); }
+
+    /**
+     * @brief Get the recorded length of a block
+     * @param block Block index
+     * @param fallback Length returned when the host block size was not recorded
+     */
+    int getBlockSize(size_t block, int fallback) const {
+        const int numSamples = blocks[block].numSamples;
+        return numSamples > 0 ? numSamples : fallback;
+    }
+
+    /**
+     * @brief Get the longest recorded block (for prepareToPlay)
+     * @param fallback Length assumed for blocks whose size was not recorded
+     */
+    int getMaxBlockSize(int fallback) const {
+        int maxSize = 0;
+        for (size_t i = 0; i < blocks.size(); ++i)
+            maxSize = std::max(maxSize, getBlockSize(i, fallback));
+        return maxSize;
+    }
+
+    /**
+     * @brief Visit the events of a block in recorded order
+     * @param block Block index
+     * @param fn Callable invoked as fn(const Event&)
+     */
+    template <typename Fn>
+    void forEachEvent(size_t block, Fn&& fn) const {
+        const auto& b = blocks[block];
+        for (size_t i = b.firstEvent; i < b.firstEvent + b.numEvents; ++i)
+            fn(events[i]);
+    }
+
+    /**
+     * @brief Feed the events of a block into a parameter manager (call before processBlock)
+     * @param block Block index
+     * @param manager ParameterManager of the processor under test
+     */
+    template <typename Manager>
+    void applyBlock(size_t block, Manager& manager) const {
+        forEachEvent(block, [&manager](const Event& event) {
+            const auto id = static_cast<typename Manager::ID>(event.index);
+            if (event.sampleOffset == automation_format::untimestamped)
+                manager.postValue(id, event.value);
+            else
+                manager.pushEvent(id, event.value, event.sampleOffset);
+        });
+    }
+
+  private:
+    // Range of events belonging to a block
+    struct Block {
+        int numSamples;
+        size_t firstEvent;
+        size_t numEvents;
+    };
+
+    std::vector<Block> blocks; // Recorded blocks
+    std::vector<Event> events; // Events of all blocks, in recorded order
+    double sampleRate = 0.0;   // Sample rate of the recorded session
+};
+
+} // namespace jnsc::juce_interface
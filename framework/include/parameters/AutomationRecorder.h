@@ -0,0 +1,208 @@
+// Jonssonic Plugin Framework
+// Automation recorder - captures parameter events to a compact binary file
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Binary automation capture layout
+ *
+ * Header: magic, format version, sample rate in Hz (int32 each).
+ * Body: one 12-byte record per event: {uint32 block index, int16 sample
+ * offset, int16 parameter index, float native value}. All fields are
+ * little-endian. A record with parameter index -1 marks the start of a block
+ * and carries its length in samples as the value (0 = unknown). A sample
+ * offset of -1 marks an untimestamped change (GUI, host automation) applied
+ * at the start of the block.
+ */
+namespace automation_format {
+inline constexpr int magic = 0x41534E4A; // "JNSA" read as little-endian int
+inline constexpr int formatVersion = 1;
+inline constexpr int headerSize = 12;
+inline constexpr int recordSize = 12;
+inline constexpr int blockMarker = -1;
+inline constexpr int untimestamped = -1;
+} // namespace automation_format
+
+/**
+ * @brief Records parameter events of a live session for offline replay
+ *
+ * The audio thread pushes records into a lock-free FIFO; a background thread
+ * writes them to disk. When recording is off, the audio thread pays one
+ * relaxed atomic load per block. If the writer falls behind, records are
+ * dropped and counted rather than blocking the audio thread.
+ *
+ * ParameterManager owns a recorder; see startAutomationRecording(). Replay a
+ * capture with AutomationPlayer.
+ */
+class AutomationRecorder {
+  public:
+    /// Default constructor
+    AutomationRecorder() = default;
+
+    /// Destructor (stops recording and closes the file)
+    ~AutomationRecorder() { stop(); }
+
+    /// Set the sample rate written to the file header (call in prepareToPlay)
+    void setSampleRate(double newSampleRate) { sampleRate = newSampleRate; }
+
+    /**
+     * @brief Start writing a new capture (message thread)
+     * @param file Destination file (replaced if it exists)
+     * @return False if the file could not be opened
+     */
+    bool start(const juce::File& file) {
+        stop();
+
+        file.deleteFile();
+        auto output = std::make_unique<juce::FileOutputStream>(file);
+        if (!output->openedOk())
+            return false;
+
+        output->writeInt(automation_format::magic);
+        output->writeInt(automation_format::formatVersion);
+        output->writeInt(juce::roundToInt(sampleRate));
+        stream = std::move(output);
+
+        if (records.empty())
+            records.resize(fifoCapacity); // Allocated once, never touched by the audio thread while empty
+        dropped.store(0, std::memory_order_relaxed);
+
+        // A new session makes the writer skip records left over from the previous one
+        session.store(session.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        writerThread = std::make_unique<WriterThread>(*this);
+        writerThread->startThread();
+        recording.store(true, std::memory_order_release);
+        return true;
+    }
+
+    /// Stop recording, write the remaining records and close the file (message thread)
+    void stop() {
+        recording.store(false, std::memory_order_release);
+        if (writerThread) {
+            writerThread->signalThreadShouldExit();
+            writerThread->stopThread(1000);
+            writerThread.reset();
+        }
+        if (stream) {
+            writePending();
+            stream->flush();
+            stream.reset();
+        }
+    }
+
+    /// Check if a capture is being written
+    bool isRecording() const { return recording.load(std::memory_order_relaxed); }
+
+    /// Get the number of records lost because the writer fell behind (any thread)
+    uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Start a new block (audio thread)
+     * @param numSamples Block length in samples (0 = unknown)
+     */
+    void beginBlock(int numSamples) {
+        active = recording.load(std::memory_order_acquire);
+        if (!active)
+            return;
+
+        const uint32_t current = session.load(std::memory_order_acquire);
+        if (current != activeSession) {
+            activeSession = current;
+            blockIndex = 0;
+        } else {
+            ++blockIndex;
+        }
+        push(automation_format::blockMarker, static_cast<float>(numSamples), 0);
+    }
+
+    /**
+     * @brief Record a parameter event of the current block (audio thread)
+     * @param index Parameter table index
+     * @param value Native value
+     * @param sampleOffset Offset in the block, or automation_format::untimestamped
+     */
+    void record(size_t index, float value, int sampleOffset) {
+        if (active)
+            push(static_cast<int>(index), value, sampleOffset);
+    }
+
+  private:
+    static constexpr int fifoCapacity = 8192; // Records buffered between writer passes
+    static constexpr int pollIntervalMs = 10; // Writer thread polling interval
+
+    // Record as queued (the session is not written to the file)
+    struct Record {
+        uint32_t session;
+        uint32_t block;
+        int16_t sampleOffset;
+        int16_t index;
+        float value;
+    };
+
+    // Background thread writing queued records to the file
+    class WriterThread : public juce::Thread {
+      public:
+        explicit WriterThread(AutomationRecorder& recorder) : juce::Thread("AutomationRecorder"), owner(recorder) {}
+
+        void run() override {
+            while (!threadShouldExit()) {
+                owner.writePending();
+                wait(pollIntervalMs);
+            }
+        }
+
+      private:
+        AutomationRecorder& owner;
+    };
+
+    void push(int index, float value, int sampleOffset) {
+        const auto scope = fifo.write(1);
+        if (scope.blockSize1 + scope.blockSize2 == 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        const auto offset = static_cast<int16_t>(std::clamp(sampleOffset, -1, 32767));
+        const int slot = scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2;
+        records[static_cast<size_t>(slot)] = {activeSession, blockIndex, offset, static_cast<int16_t>(index), value};
+    }
+
+    // Drain the FIFO into the file (writer thread, or message thread once it stopped)
+    void writePending() {
+        const uint32_t current = session.load(std::memory_order_acquire);
+        const auto scope = fifo.read(fifo.getNumReady());
+        scope.forEach([this, current](int slot) {
+            const auto& r = records[static_cast<size_t>(slot)];
+            if (r.session != current)
+                return;
+            stream->writeInt(static_cast<int>(r.block));
+            stream->writeShort(r.sampleOffset);
+            stream->writeShort(r.index);
+            stream->writeFloat(r.value);
+        });
+    }
+
+    juce::AbstractFifo fifo{fifoCapacity};          // Positions in records
+    std::vector<Record> records;                    // FIFO storage
+    std::unique_ptr<juce::FileOutputStream> stream; // Capture file
+    std::unique_ptr<WriterThread> writerThread;     // Writes records to the file
+    std::atomic<bool> recording{false};             // Requested by start()/stop()
+    std::atomic<uint32_t> session{0};               // Incremented by start()
+    std::atomic<uint64_t> dropped{0};               // Records lost to a full FIFO
+    double sampleRate = 44100.0;                    // Written to the file header
+    bool active = false;                            // Recording the current block (audio thread)
+    uint32_t activeSession = 0;                     // Session of the current block (audio thread)
+    uint32_t blockIndex = 0;                        // Blocks since the session started (audio thread)
+};
+
+} // namespace jnsc::juce_interface
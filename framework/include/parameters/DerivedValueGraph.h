@@ -0,0 +1,156 @@
+// Jonssonic Plugin Framework
+// Derived value graph - lazy recomputation of parameter-dependent state
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Dependency graph for expensive parameter-dependent state
+ *
+ * Each node declares the parameters (and earlier nodes) it depends on and a
+ * recompute function, e.g., rebuilding filter coefficients or a waveshaper
+ * table. Parameter changes only mark nodes dirty; evaluate() runs every dirty
+ * node once, in registration order, so several changes within a block cost a
+ * single rebuild. Counters report how many rebuilds were saved.
+ *
+ * Example usage:
+ * @code
+ *   DerivedValueGraph<> derived;
+ *   derived.add({ID::Shape}, [this](bool skipSmoothing) {
+ *       distortion.setShape(parameterManager.getFrame()[ID::Shape] * 0.01f, skipSmoothing);
+ *   });
+ *   parameterManager.setDerivedValues(&derived); // Evaluated before each (sub-)block
+ * @endcode
+ *
+ * @tparam NumSlots Number of parameter slots (ParameterManager MaxParams)
+ * @tparam MaxNodes Maximum number of derived values
+ */
+template <size_t NumSlots = 64, size_t MaxNodes = 16>
+class DerivedValueGraph {
+  public:
+    /**
+     * @brief Recompute function of a node
+     * @param skipSmoothing True if any input jumped (state load, syncAll)
+     */
+    using Recompute = std::function<void(bool)>;
+
+    /**
+     * @brief Add a derived value (call before processing starts)
+     * @param parameters Parameter IDs the value depends on
+     * @param recompute Function rebuilding the value (audio thread)
+     * @param inputs Earlier nodes the value depends on
+     * @return Node index, or -1 if the graph is full
+     */
+    template <typename IDType>
+    int add(std::initializer_list<IDType> parameters, Recompute recompute, std::initializer_list<int> inputs = {}) {
+        if (numNodes == MaxNodes)
+            return -1;
+
+        const size_t node = numNodes++;
+        for (auto id : parameters) {
+            const auto slot = static_cast<size_t>(id);
+            if (slot < NumSlots)
+                parameterDependents[slot].set(node);
+        }
+        for (auto input : inputs) {
+            if (input >= 0 && static_cast<size_t>(input) < node)
+                nodeDependents[static_cast<size_t>(input)].set(node);
+        }
+        recomputes[node] = std::move(recompute);
+        dirty.set(node); // Built on the first evaluation
+        return static_cast<int>(node);
+    }
+
+    /**
+     * @brief Mark the nodes depending on a parameter dirty (audio thread)
+     * @param slot Parameter slot (enum value)
+     * @param skipSmoothing True if the change should not be smoothed
+     */
+    void invalidate(size_t slot, bool skipSmoothing = false) {
+        const auto& dependents = parameterDependents[slot];
+        if (dependents.none())
+            return;
+
+        invalidations.fetch_add(1, std::memory_order_relaxed);
+        if ((dependents & ~dirty).none())
+            saved.fetch_add(1, std::memory_order_relaxed); // Already pending: no extra rebuild
+        dirty |= dependents;
+        if (skipSmoothing)
+            jumped |= dependents;
+    }
+
+    /**
+     * @brief Mark every node dirty
+     * @param skipSmoothing True if the rebuild should not be smoothed
+     */
+    void invalidateAll(bool skipSmoothing = true) {
+        for (size_t i = 0; i < numNodes; ++i) {
+            dirty.set(i);
+            jumped.set(i, skipSmoothing);
+        }
+    }
+
+    /// Recompute every dirty node once, in registration order (audio thread)
+    void evaluate() {
+        for (size_t i = 0; i < numNodes && dirty.any(); ++i) {
+            if (!dirty[i])
+                continue;
+
+            const bool skipSmoothing = jumped[i];
+            dirty.reset(i);
+            jumped.reset(i);
+            recomputes[i](skipSmoothing);
+            recomputeCount.fetch_add(1, std::memory_order_relaxed);
+
+            // Dependent nodes are later in the order, so they run in this pass
+            dirty |= nodeDependents[i];
+            if (skipSmoothing)
+                jumped |= nodeDependents[i];
+        }
+    }
+
+    /// Check if a node is waiting for evaluation
+    bool isDirty(int node) const { return dirty[static_cast<size_t>(node)]; }
+
+    /// Get the number of nodes
+    size_t size() const { return numNodes; }
+
+    /// Get the number of recomputations performed (any thread)
+    uint64_t getRecomputeCount() const { return recomputeCount.load(std::memory_order_relaxed); }
+
+    /// Get the number of parameter changes that reached a node (any thread)
+    uint64_t getInvalidationCount() const { return invalidations.load(std::memory_order_relaxed); }
+
+    /// Get the number of changes absorbed by an already pending rebuild (any thread)
+    uint64_t getSavedCount() const { return saved.load(std::memory_order_relaxed); }
+
+    /// Reset the counters (any thread)
+    void resetCounters() {
+        recomputeCount.store(0, std::memory_order_relaxed);
+        invalidations.store(0, std::memory_order_relaxed);
+        saved.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    std::array<std::bitset<MaxNodes>, NumSlots> parameterDependents; // Nodes per parameter slot
+    std::array<std::bitset<MaxNodes>, MaxNodes> nodeDependents;      // Nodes per input node
+    std::array<Recompute, MaxNodes> recomputes;                      // Recompute function per node
+    size_t numNodes = 0;                                             // Number of nodes
+    std::bitset<MaxNodes> dirty;                                     // Nodes awaiting evaluation
+    std::bitset<MaxNodes> jumped;                                    // Dirty nodes that skip smoothing
+    std::atomic<uint64_t> recomputeCount{0};                         // Recomputations performed
+    std::atomic<uint64_t> invalidations{0};                          // Changes that reached a node
+    std::atomic<uint64_t> saved{0};                                  // Changes absorbed by a pending rebuild
+};
+
+} // namespace jnsc::juce_interface
@@ -0,0 +1,193 @@
+// Jonssonic Plugin Framework
+// Host notification throttle - rate-limited host updates for GUI-driven changes
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Coalesces GUI parameter changes into host notifications at a fixed rate
+ *
+ * Some hosts spend significant message-thread time recording automation and
+ * redrawing lanes for every setValueNotifyingHost(). The throttle keeps the
+ * latest pending value per parameter and notifies the host at most at the
+ * configured rate. Every change is wrapped in a change gesture: either the
+ * caller's (beginGesture()/endGesture()), or one the throttle opens on the
+ * first change and closes once the parameter has been idle for a tick. The
+ * final value of a gesture is always sent before the gesture ends.
+ *
+ * Message thread only. ParameterManager forwards its changes to the audio
+ * thread separately, so the DSP is not rate limited.
+ *
+ * @tparam MaxParams Capacity of the parameter table
+ */
+template <size_t MaxParams>
+class HostNotificationThrottle : private juce::Timer {
+  public:
+    /// Sends a pending value to the host, invoked as send(index, normalizedValue)
+    using SendFunction = std::function<void(size_t, float)>;
+
+    /// Default constructor
+    HostNotificationThrottle() = default;
+
+    /// Destructor (sends pending values and closes open gestures)
+    ~HostNotificationThrottle() override { flushAll(); }
+
+    /**
+     * @brief Register the parameter of a slot
+     * @param index Parameter table index
+     * @param parameter Parameter to notify the host through
+     */
+    void attach(size_t index, juce::AudioProcessorParameter* parameter) { parameters[index] = parameter; }
+
+    /**
+     * @brief Replace how a pending value is sent (call before the first set())
+     *
+     * By default the throttle calls setValueNotifyingHost() on the registered
+     * parameter. A custom function must notify the host itself, and can track
+     * which notifications come from the throttle.
+     *
+     * @param fn Send function (empty = default)
+     */
+    void setSendFunction(SendFunction fn) { sendFunction = std::move(fn); }
+
+    /**
+     * @brief Set the notification rate
+     * @param hz Maximum host notifications per second per parameter (0 = notify on every change)
+     */
+    void setRate(float hz) {
+        if (hz <= 0.0f) {
+            flushAll();
+            rateHz = 0;
+            return;
+        }
+        rateHz = std::max(1, static_cast<int>(std::lround(hz)));
+        if (isTimerRunning())
+            startTimerHz(rateHz);
+    }
+
+    /// Check if changes are being throttled
+    bool isEnabled() const { return rateHz > 0; }
+
+    /**
+     * @brief Queue a new value for the host
+     * @param index Parameter table index
+     * @param normalizedValue New normalized value [0, 1]
+     */
+    void set(size_t index, float normalizedValue) {
+        auto* parameter = parameters[index];
+        if (parameter == nullptr)
+            return;
+
+        if (!userGesture[index] && !ownGesture[index]) {
+            parameter->beginChangeGesture();
+            ownGesture.set(index);
+        }
+        pendingValues[index] = normalizedValue;
+        pending.set(index);
+        changedSinceTick.set(index);
+        if (!isTimerRunning())
+            startTimerHz(rateHz);
+    }
+
+    /**
+     * @brief Begin a caller-controlled change gesture (e.g., mouse down on a knob)
+     * @param index Parameter table index
+     */
+    void beginGesture(size_t index) {
+        auto* parameter = parameters[index];
+        if (parameter == nullptr || userGesture[index])
+            return;
+
+        // A gesture the throttle opened is taken over rather than restarted
+        if (!ownGesture[index])
+            parameter->beginChangeGesture();
+        ownGesture.reset(index);
+        userGesture.set(index);
+    }
+
+    /**
+     * @brief End a caller-controlled gesture, sending the final value first
+     * @param index Parameter table index
+     */
+    void endGesture(size_t index) {
+        auto* parameter = parameters[index];
+        if (parameter == nullptr || !userGesture[index])
+            return;
+
+        flush(index);
+        parameter->endChangeGesture();
+        userGesture.reset(index);
+    }
+
+    /// Send all pending values and close the gestures the throttle opened
+    void flushAll() {
+        for (size_t i = 0; i < MaxParams; ++i) {
+            flush(i);
+            closeOwnGesture(i);
+        }
+        stopTimer();
+    }
+
+    /// Drop all pending values and close the gestures the throttle opened (e.g., before a state load)
+    void discardAll() {
+        pending.reset();
+        changedSinceTick.reset();
+        for (size_t i = 0; i < MaxParams; ++i)
+            closeOwnGesture(i);
+        stopTimer();
+    }
+
+  private:
+    void timerCallback() override {
+        bool busy = false;
+        for (size_t i = 0; i < MaxParams; ++i) {
+            flush(i);
+            if (ownGesture[i] && !changedSinceTick[i])
+                closeOwnGesture(i); // Idle for a whole tick: the drag has ended
+            busy = busy || ownGesture[i];
+        }
+        changedSinceTick.reset();
+        if (!busy)
+            stopTimer();
+    }
+
+    // Send the pending value of a slot, if any
+    void flush(size_t index) {
+        if (!pending[index])
+            return;
+        pending.reset(index);
+        if (sendFunction)
+            sendFunction(index, pendingValues[index]);
+        else
+            parameters[index]->setValueNotifyingHost(pendingValues[index]);
+    }
+
+    void closeOwnGesture(size_t index) {
+        if (!ownGesture[index])
+            return;
+        ownGesture.reset(index);
+        parameters[index]->endChangeGesture();
+    }
+
+    std::array<juce::AudioProcessorParameter*, MaxParams> parameters{}; // Registered parameters
+    std::array<float, MaxParams> pendingValues{};                       // Latest normalized value per slot
+    std::bitset<MaxParams> pending;                                     // Slots with a value not yet sent
+    std::bitset<MaxParams> changedSinceTick;                            // Slots changed since the last tick
+    std::bitset<MaxParams> ownGesture;                                  // Gestures opened by the throttle
+    std::bitset<MaxParams> userGesture;                                 // Gestures opened by the caller
+    SendFunction sendFunction;                                          // Custom send (empty = notify directly)
+    int rateHz = 0;                                                     // Notification rate (0 = off)
+};
+
+} // namespace jnsc::juce_interface
@@ -0,0 +1,159 @@
+// Jonssonic Plugin Framework
+// MIDI learn - lock-free MIDI CC to parameter routing
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "SnapshotExchange.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief MIDI CC to parameter routing with learn mode
+ *
+ * The message thread edits the routing and commits it; commit() flattens the
+ * per-channel and omni mappings into one table of 16 x 128 entries and hands
+ * it to the audio thread through a SnapshotExchange. On the audio thread each
+ * CC message costs a single table lookup.
+ *
+ * Learn mode: after startLearn(slot), the next CC seen by the audio thread is
+ * reported back, and pollLearned() (message thread, e.g., from a timer) maps
+ * it to the slot on any channel.
+ *
+ * @tparam NumSlots Number of parameter slots (ParameterManager MaxParams)
+ */
+template <size_t NumSlots>
+class MidiLearn {
+  public:
+    static constexpr int numChannels = 16;     // MIDI channels
+    static constexpr int numControllers = 128; // Controller numbers per channel
+    static constexpr int anyChannel = 0;       // Channel value for omni mappings
+
+    /// Flattened routing: parameter slot per (channel, controller), -1 if unmapped
+    struct Routing {
+        std::array<int16_t, numChannels * numControllers> targets;
+    };
+
+    /// Default constructor
+    MidiLearn() {
+        omni.fill(-1);
+        for (auto& channel : perChannel)
+            channel.fill(-1);
+        commit();
+    }
+
+    /**
+     * @brief Map a controller to a parameter (message thread, takes effect on commit())
+     * @param channel MIDI channel [1, 16], or anyChannel
+     * @param controller Controller number [0, 127]
+     * @param slot Parameter slot (enum value)
+     */
+    void map(int channel, int controller, size_t slot) {
+        if (controller < 0 || controller >= numControllers || slot >= NumSlots)
+            return;
+        if (channel == anyChannel)
+            omni[static_cast<size_t>(controller)] = static_cast<int16_t>(slot);
+        else if (channel >= 1 && channel <= numChannels)
+            perChannel[static_cast<size_t>(channel - 1)][static_cast<size_t>(controller)] = static_cast<int16_t>(slot);
+    }
+
+    /**
+     * @brief Remove every mapping to a parameter (message thread, takes effect on commit())
+     * @param slot Parameter slot (enum value)
+     */
+    void unmap(size_t slot) {
+        auto clearSlot = [slot](auto& table) {
+            for (auto& target : table) {
+                if (target == static_cast<int16_t>(slot))
+                    target = -1;
+            }
+        };
+        clearSlot(omni);
+        for (auto& channel : perChannel)
+            clearSlot(channel);
+    }
+
+    /// Remove all mappings (message thread, takes effect on commit())
+    void clear() {
+        omni.fill(-1);
+        for (auto& channel : perChannel)
+            channel.fill(-1);
+    }
+
+    /// Flatten the mappings and hand them to the audio thread (message thread)
+    void commit() {
+        auto& routing = exchange.beginWrite();
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            for (size_t cc = 0; cc < numControllers; ++cc) {
+                const int16_t specific = perChannel[ch][cc];
+                routing.targets[ch * numControllers + cc] = specific >= 0 ? specific : omni[cc];
+            }
+        }
+        exchange.publish();
+    }
+
+    /**
+     * @brief Map the next incoming CC to a parameter (message thread)
+     * @param slot Parameter slot (enum value)
+     */
+    void startLearn(size_t slot) {
+        learned.store(-1, std::memory_order_relaxed);
+        learnSlot.store(static_cast<int>(slot), std::memory_order_release);
+    }
+
+    /// Cancel learn mode (message thread)
+    void stopLearn() { learnSlot.store(-1, std::memory_order_release); }
+
+    /// Check if learn mode is waiting for a CC
+    bool isLearning() const { return learnSlot.load(std::memory_order_acquire) >= 0; }
+
+    /**
+     * @brief Complete learn mode if a CC arrived (message thread)
+     * @return True if a new mapping was committed
+     */
+    bool pollLearned() {
+        const int controller = learned.exchange(-1, std::memory_order_acquire);
+        const int slot = learnSlot.load(std::memory_order_acquire);
+        if (controller < 0 || slot < 0)
+            return false;
+
+        map(anyChannel, controller, static_cast<size_t>(slot));
+        commit();
+        stopLearn();
+        return true;
+    }
+
+    /// Pick up a newly committed routing (audio thread, once per block)
+    void beginBlock() {
+        if (const auto* routing = exchange.acquire())
+            active = routing;
+    }
+
+    /**
+     * @brief Resolve a CC message (audio thread)
+     * @param channel MIDI channel [1, 16]
+     * @param controller Controller number [0, 127]
+     * @return Parameter slot, or -1 if unmapped
+     */
+    int handleController(int channel, int controller) {
+        if (learnSlot.load(std::memory_order_relaxed) >= 0)
+            learned.store(controller, std::memory_order_release);
+
+        return active->targets[static_cast<size_t>((channel - 1) * numControllers + controller)];
+    }
+
+  private:
+    std::array<int16_t, numControllers> omni;                                // Omni mappings (message thread)
+    std::array<std::array<int16_t, numControllers>, numChannels> perChannel; // Per-channel mappings (message thread)
+    SnapshotExchange<Routing> exchange;                                      // Flattened routing for the audio thread
+    const Routing* active = nullptr;                                         // Routing in use (audio thread)
+    std::atomic<int> learnSlot{-1};                                          // Slot awaiting a CC (-1 = off)
+    std::atomic<int> learned{-1};                                            // CC seen while learning (-1 = none)
+};
+
+} // namespace jnsc::juce_interface
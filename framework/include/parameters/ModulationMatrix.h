@@ -0,0 +1,271 @@
+// Jonssonic Plugin Framework
+// Modulation matrix - block-rate LFOs, envelope follower and macros for any parameter
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "SnapshotExchange.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief LFO waveform
+ */
+enum class LfoShape { Sine, Triangle, Saw, Square };
+
+/**
+ * @brief Control-rate modulation matrix
+ *
+ * Sources: numLfos bipolar LFOs, one unipolar input envelope follower and
+ * numMacros unipolar macro knobs. Routing is a dense depth matrix
+ * (source x parameter slot), so each control tick is one multiply-add pass
+ * over flat arrays per source. Offsets are in normalized [0, 1] units and are
+ * added to the host value by ParameterManager, which never writes them back
+ * to the host.
+ *
+ * Example usage:
+ * @code
+ *   ModulationMatrix<> modulation;
+ *   parameterManager.setModulation(&modulation);
+ *
+ *   // Message thread:
+ *   modulation.setLfo(0, 0.5f, LfoShape::Sine);
+ *   modulation.setDepth(ModulationMatrix<>::lfoSource(0), static_cast<size_t>(ID::HighMidFreq), 0.2f);
+ *   modulation.commitRouting();
+ *
+ *   // prepareToPlay:
+ *   modulation.prepare(sampleRate);
+ *
+ *   // processBlock: passing the buffer feeds each sub-block's input to the envelope follower
+ *   parameterManager.processSubBlocks(buffer, numInputChannels, [&](int start, int length) { ... });
+ * @endcode
+ *
+ * @tparam NumSlots Number of parameter slots (ParameterManager MaxParams)
+ */
+template <size_t NumSlots = 64>
+class ModulationMatrix {
+  public:
+    static constexpr size_t numLfos = 4;                          // Number of LFO sources
+    static constexpr size_t numMacros = 4;                        // Number of macro sources
+    static constexpr size_t numSources = numLfos + 1 + numMacros; // Total number of sources
+    static constexpr int controlBlockSize = 32;                   // Samples per control tick
+
+    /// Source index of an LFO
+    static constexpr size_t lfoSource(size_t lfo) { return lfo; }
+
+    /// Source index of the input envelope follower
+    static constexpr size_t envelopeSource() { return numLfos; }
+
+    /// Source index of a macro
+    static constexpr size_t macroSource(size_t macro) { return numLfos + 1 + macro; }
+
+    /// Dense routing: depth per source and parameter slot
+    struct Routing {
+        std::array<std::array<float, NumSlots>, numSources> depth{};
+    };
+
+    /// Default constructor
+    ModulationMatrix() {
+        for (auto& lfo : lfos) {
+            lfo.rateHz.store(1.0f, std::memory_order_relaxed);
+            lfo.shape.store(LfoShape::Sine, std::memory_order_relaxed);
+        }
+        for (auto& macro : macros)
+            macro.store(0.0f, std::memory_order_relaxed);
+        offsets.fill(0.0f);
+        modulated.fill(false);
+    }
+
+    /**
+     * @brief Prepare sources (call in prepareToPlay)
+     * @param newSampleRate Sample rate in Hz
+     */
+    void prepare(double newSampleRate) {
+        sampleRate = newSampleRate;
+        for (auto& phase : lfoPhases)
+            phase = 0.0f;
+        envelope = 0.0f;
+        inputPeak = 0.0f;
+    }
+
+    /**
+     * @brief Configure an LFO (any thread)
+     * @param lfo LFO index [0, numLfos)
+     * @param rateHz Rate in Hz
+     * @param shape Waveform
+     */
+    void setLfo(size_t lfo, float rateHz, LfoShape shape) {
+        lfos[lfo].rateHz.store(rateHz, std::memory_order_relaxed);
+        lfos[lfo].shape.store(shape, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Configure the envelope follower (any thread)
+     * @param attackMs Attack time in milliseconds
+     * @param releaseMs Release time in milliseconds
+     */
+    void setEnvelope(float attackMs, float releaseMs) {
+        envelopeAttackMs.store(attackMs, std::memory_order_relaxed);
+        envelopeReleaseMs.store(releaseMs, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Set a macro knob (any thread)
+     * @param macro Macro index [0, numMacros)
+     * @param value Value [0, 1]
+     */
+    void setMacro(size_t macro, float value) { macros[macro].store(value, std::memory_order_relaxed); }
+
+    /**
+     * @brief Set a route depth (message thread, takes effect on commitRouting())
+     * @param source Source index (see lfoSource(), envelopeSource(), macroSource())
+     * @param slot Parameter slot (enum value of a FloatParam)
+     * @param depth Depth in normalized units [-1, 1] (0 removes the route)
+     */
+    void setDepth(size_t source, size_t slot, float depth) { editRouting.depth[source][slot] = depth; }
+
+    /// Remove all routes (message thread, takes effect on commitRouting())
+    void clearRouting() { editRouting = Routing{}; }
+
+    /// Hand the edited routing to the audio thread (message thread)
+    void commitRouting() {
+        routingExchange.beginWrite() = editRouting;
+        routingExchange.publish();
+    }
+
+    /**
+     * @brief Feed the input of the next tick to the envelope follower (audio thread)
+     * @param channels Input channel pointers (float or double)
+     * @param numChannels Number of channels
+     * @param startSample First sample of the range
+     * @param numSamples Number of samples
+     */
+    template <typename SampleType>
+    void processInput(const SampleType* const* channels, int numChannels, int startSample, int numSamples) {
+        SampleType peak = 0;
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const SampleType* input = channels[ch] + startSample;
+            for (int i = 0; i < numSamples; ++i)
+                peak = std::max(peak, std::abs(input[i]));
+        }
+        inputPeak = static_cast<float>(peak);
+    }
+
+    /**
+     * @brief Switch to the last committed routing, if any (audio thread)
+     *
+     * Called by tick(); call it earlier when hasRoutes() must reflect a
+     * routing committed since the previous tick.
+     */
+    void acquireRouting() {
+        if (const auto* routing = routingExchange.acquire())
+            setActiveRouting(routing);
+    }
+
+    /**
+     * @brief Advance all sources by one control tick and compute offsets (audio thread)
+     * @param numSamples Samples covered by this tick
+     */
+    void tick(int numSamples) {
+        acquireRouting();
+
+        const float seconds = static_cast<float>(numSamples / sampleRate);
+        std::array<float, numSources> sources{};
+
+        for (size_t i = 0; i < numLfos; ++i) {
+            sources[lfoSource(i)] = evaluateLfo(lfos[i].shape.load(std::memory_order_relaxed), lfoPhases[i]);
+            lfoPhases[i] += lfos[i].rateHz.load(std::memory_order_relaxed) * seconds;
+            lfoPhases[i] -= std::floor(lfoPhases[i]);
+        }
+
+        const float timeMs = inputPeak > envelope ? envelopeAttackMs.load(std::memory_order_relaxed)
+                                                  : envelopeReleaseMs.load(std::memory_order_relaxed);
+        const float coeff = timeMs > 0.0f ? std::exp(-1000.0f * seconds / timeMs) : 0.0f;
+        envelope = inputPeak + coeff * (envelope - inputPeak);
+        sources[envelopeSource()] = std::min(envelope, 1.0f);
+
+        for (size_t i = 0; i < numMacros; ++i)
+            sources[macroSource(i)] = macros[i].load(std::memory_order_relaxed);
+
+        offsets.fill(0.0f);
+        if (!anyRouted)
+            return;
+
+        // Dense multiply-add per source (vectorizes over parameter slots)
+        for (size_t s = 0; s < numSources; ++s) {
+            const float value = sources[s];
+            const float* depth = activeRouting->depth[s].data();
+            for (size_t i = 0; i < NumSlots; ++i)
+                offsets[i] += value * depth[i];
+        }
+    }
+
+    /// Check if any route is active on the audio thread
+    bool hasRoutes() const { return anyRouted; }
+
+    /// Check if a parameter slot has at least one route (audio thread)
+    bool isModulated(size_t slot) const { return modulated[slot]; }
+
+    /// Get the offset of a parameter slot from the last tick, in normalized units (audio thread)
+    float getOffset(size_t slot) const { return offsets[slot]; }
+
+  private:
+    // LFO settings shared with the message thread
+    struct LfoSettings {
+        std::atomic<float> rateHz;
+        std::atomic<LfoShape> shape;
+    };
+
+    // Switch to a newly committed routing and cache which slots it targets
+    void setActiveRouting(const Routing* routing) {
+        activeRouting = routing;
+        anyRouted = false;
+        for (size_t i = 0; i < NumSlots; ++i) {
+            bool routed = false;
+            for (size_t s = 0; s < numSources; ++s)
+                routed = routed || routing->depth[s][i] != 0.0f;
+            modulated[i] = routed;
+            anyRouted = anyRouted || routed;
+        }
+    }
+
+    // Bipolar waveform at a phase in [0, 1)
+    static float evaluateLfo(LfoShape shape, float phase) {
+        switch (shape) {
+        case LfoShape::Triangle:
+            return 1.0f - 4.0f * std::abs(phase - 0.5f);
+        case LfoShape::Saw:
+            return 2.0f * phase - 1.0f;
+        case LfoShape::Square:
+            return phase < 0.5f ? 1.0f : -1.0f;
+        case LfoShape::Sine:
+        default:
+            return std::sin(6.28318530718f * phase);
+        }
+    }
+
+    std::array<LfoSettings, numLfos> lfos;            // LFO rates and shapes
+    std::array<std::atomic<float>, numMacros> macros; // Macro values
+    std::atomic<float> envelopeAttackMs{10.0f};       // Envelope follower attack
+    std::atomic<float> envelopeReleaseMs{200.0f};     // Envelope follower release
+
+    Routing editRouting;                       // Routing being edited (message thread)
+    SnapshotExchange<Routing> routingExchange; // Committed routing for the audio thread
+    const Routing* activeRouting = nullptr;    // Routing in use (audio thread)
+
+    double sampleRate = 44100.0;            // Current sample rate
+    std::array<float, numLfos> lfoPhases{}; // LFO phases [0, 1)
+    float envelope = 0.0f;                  // Envelope follower state
+    float inputPeak = 0.0f;                 // Peak of the last input range
+    std::array<float, NumSlots> offsets;    // Offsets from the last tick (normalized)
+    std::array<bool, NumSlots> modulated;   // Slots with at least one route
+    bool anyRouted = false;                 // True if any slot has a route
+};
+
+} // namespace jnsc::juce_interface
@@ -0,0 +1,79 @@
+// Jonssonic Plugin Framework
+// Parameter frame - per-block snapshot of native parameter values
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <cstddef>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Native parameter values for one (sub-)block, with change flags
+ *
+ * Pull-model alternative to ParameterManager::on() callbacks: the DSP reads
+ * the frame once per block and only recomputes what the changed mask flags.
+ * Everything is a plain array access, so the hot path inlines fully.
+ *
+ * Example usage:
+ * @code
+ *   parameterManager.processSubBlocks(numSamples, [&](int start, int length) {
+ *       const auto& frame = parameterManager.getFrame();
+ *       if (frame.hasChanged(ID::Cutoff))
+ *           filter.setCutoff(frame[ID::Cutoff], frame.shouldSkipSmoothing(ID::Cutoff));
+ *       ...
+ *   });
+ * @endcode
+ *
+ * @tparam IDType Parameter ID enum (values must be contiguous from 0)
+ * @tparam MaxParams Capacity of the parameter table
+ */
+template <typename IDType, size_t MaxParams = 64>
+struct ParamFrame {
+    std::array<float, MaxParams> values{}; // Native values (smoothed params: ramp value at the sub-block end)
+    std::bitset<MaxParams> changed;        // Parameters that changed since the previous frame
+    std::bitset<MaxParams> jumped;         // Changed parameters that should skip DSP smoothing
+
+    /// Get a native value
+    float operator[](IDType id) const { return values[toIndex(id)]; }
+
+    /// Get a native value
+    float get(IDType id) const { return values[toIndex(id)]; }
+
+    /// Get an integer or choice index value
+    int getInt(IDType id) const { return static_cast<int>(std::lround(values[toIndex(id)])); }
+
+    /// Get a boolean value
+    bool getBool(IDType id) const { return values[toIndex(id)] >= 0.5f; }
+
+    /// Check if a parameter changed since the previous frame
+    bool hasChanged(IDType id) const { return changed[toIndex(id)]; }
+
+    /// Check if a changed parameter should skip DSP smoothing (state loads, syncAll)
+    bool shouldSkipSmoothing(IDType id) const { return jumped[toIndex(id)]; }
+
+    /// Check if any parameter changed since the previous frame
+    bool anyChanged() const { return changed.any(); }
+
+    /**
+     * @brief Visit every changed parameter
+     * @param fn Callable invoked as fn(IDType id, float value, bool skipSmoothing)
+     */
+    template <typename Fn>
+    void forEachChanged(Fn&& fn) const {
+        if (changed.none())
+            return;
+        for (size_t i = 0; i < MaxParams; ++i) {
+            if (changed[i])
+                fn(static_cast<IDType>(i), values[i], jumped[i]);
+        }
+    }
+
+  private:
+    static size_t toIndex(IDType id) { return static_cast<size_t>(id); }
+};
+
+} // namespace jnsc::juce_interface
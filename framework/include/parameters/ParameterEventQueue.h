@@ -0,0 +1,75 @@
+// Jonssonic Plugin Framework
+// Parameter event queue - timestamped parameter changes within a block
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Timestamped parameter change
+ * @param index Parameter table index (enum value)
+ * @param value New value in native range
+ * @param sampleOffset Sample offset within the current block
+ */
+struct ParameterEvent {
+    size_t index;
+    float value;
+    int sampleOffset;
+};
+
+/**
+ * @brief Fixed-capacity queue of timestamped parameter events (audio thread only)
+ *
+ * Events are kept sorted by sample offset on insertion. Events with equal
+ * offsets keep their insertion order. No allocation after construction.
+ *
+ * @tparam Capacity Maximum number of events per block
+ */
+template <size_t Capacity>
+class ParameterEventQueue {
+  public:
+    /// Default constructor
+    ParameterEventQueue() = default;
+
+    /**
+     * @brief Insert an event, keeping the queue sorted by sample offset
+     * @param event Event to insert
+     * @return False if the queue is full (event dropped)
+     */
+    bool push(const ParameterEvent& event) noexcept {
+        if (numEvents == Capacity)
+            return false;
+
+        // Events usually arrive in order, so this loop rarely runs
+        size_t pos = numEvents;
+        while (pos > 0 && events[pos - 1].sampleOffset > event.sampleOffset) {
+            events[pos] = events[pos - 1];
+            --pos;
+        }
+        events[pos] = event;
+        ++numEvents;
+        return true;
+    }
+
+    /// Get event at position (sorted by sample offset)
+    const ParameterEvent& operator[](size_t i) const noexcept { return events[i]; }
+
+    /// Number of queued events
+    size_t size() const noexcept { return numEvents; }
+
+    /// Check if the queue is empty
+    bool empty() const noexcept { return numEvents == 0; }
+
+    /// Remove all events
+    void clear() noexcept { numEvents = 0; }
+
+  private:
+    std::array<ParameterEvent, Capacity> events{};
+    size_t numEvents = 0;
+};
+
+} // namespace jnsc::juce_interface
@@ -7,8 +7,8 @@
 #pragma once
 
 #include "ParameterSet.h"
-#include <functional>
-#include <string>
+#include <initializer_list>
+#include <string_view>
 
 namespace jnsc::juce_interface {
 
@@ -16,26 +16,30 @@ namespace jnsc::juce_interface {
  * @brief Helper for generating groups of related parameters
  *
  * Allows defining a parameter structure once and instantiating it
- * multiple times with different IDs and names.
+ * multiple times with different IDs and names. Everything is constexpr,
+ * so groups can be expanded into a ParameterSet at compile time.
  *
  * Example:
- *   auto oscGroup = ParameterGroup<ID>()
+ *   constexpr auto oscGroup = ParameterGroup<ID>()
  *       .addFloat(0, "Frequency", 20.0f, 20000.0f, 440.0f, "Hz", 0.3f)
  *       .addFloat(1, "Level", -60.0f, 0.0f, -12.0f, "dB", 3.0f);
  *
  *   oscGroup.instantiate(params, {{ID::Osc1_Start, "Osc 1"},
  *                                  {ID::Osc2_Start, "Osc 2"}});
+ *
+ * @tparam IDType Parameter ID enum
+ * @tparam MaxSize Maximum number of parameters per group
  */
-template <typename IDType>
+template <typename IDType, size_t MaxSize = 16>
 class ParameterGroup {
   public:
     struct Instance {
         IDType baseID;
-        std::string prefix;
+        std::string_view prefix;
     };
 
     /// Default constructor
-    ParameterGroup() = default;
+    constexpr ParameterGroup() = default;
 
     /**
      * @brief Add a float parameter template to this group
@@ -46,15 +50,21 @@ class ParameterGroup {
      * @param def Default value
      * @param unit Unit string (optional)
      * @param skew Skew factor (1.0 = linear, <1.0 = logarithmic, >1.0 = exponential)
+     * @param smoothingMs Framework smoothing time in ms (0 = no framework smoothing)
+     * @param smoothingCurve Framework smoothing ramp shape
      * @return Reference to this for chaining
      */
-    ParameterGroup&
-    addFloat(int offset, std::string name, float min, float max, float def, std::string unit = "", float skew = 1.0f) {
-        generators_.push_back([=](IDType baseID, const std::string& prefix, ParameterSet<IDType>& params) {
-            auto id = static_cast<IDType>(static_cast<int>(baseID) + offset);
-            params.add(FloatParam<IDType>{id, prefix + " " + name, min, max, def, unit, skew});
-        });
-        return *this;
+    constexpr ParameterGroup& addFloat(int offset,
+                                       std::string_view name,
+                                       float min,
+                                       float max,
+                                       float def,
+                                       std::string_view unit = "",
+                                       float skew = 1.0f,
+                                       float smoothingMs = 0.0f,
+                                       SmoothingCurve smoothingCurve = SmoothingCurve::Linear) {
+        return addTemplate(FloatParam<IDType>{
+            offsetID(offset), name, min, max, def, unit, skew, smoothingMs, smoothingCurve});
     }
 
     /**
@@ -67,12 +77,9 @@ class ParameterGroup {
      * @param unit Unit string (optional)
      * @return Reference to this for chaining
      */
-    ParameterGroup& addInt(int offset, std::string name, int min, int max, int def, std::string unit = "") {
-        generators_.push_back([=](IDType baseID, const std::string& prefix, ParameterSet<IDType>& params) {
-            auto id = static_cast<IDType>(static_cast<int>(baseID) + offset);
-            params.add(IntParam<IDType>{id, prefix + " " + name, min, max, def, unit});
-        });
-        return *this;
+    constexpr ParameterGroup&
+    addInt(int offset, std::string_view name, int min, int max, int def, std::string_view unit = "") {
+        return addTemplate(IntParam<IDType>{offsetID(offset), name, min, max, def, unit});
     }
 
     /**
@@ -82,12 +89,8 @@ class ParameterGroup {
      * @param def Default value
      * @return Reference to this for chaining
      */
-    ParameterGroup& addBool(int offset, std::string name, bool def) {
-        generators_.push_back([=](IDType baseID, const std::string& prefix, ParameterSet<IDType>& params) {
-            auto id = static_cast<IDType>(static_cast<int>(baseID) + offset);
-            params.add(BoolParam<IDType>{id, prefix + " " + name, def});
-        });
-        return *this;
+    constexpr ParameterGroup& addBool(int offset, std::string_view name, bool def) {
+        return addTemplate(BoolParam<IDType>{offsetID(offset), name, def});
     }
 
     /**
@@ -98,12 +101,8 @@ class ParameterGroup {
      * @param def Default choice index
      * @return Reference to this for chaining
      */
-    ParameterGroup& addChoice(int offset, std::string name, std::vector<std::string> choices, int def) {
-        generators_.push_back([=](IDType baseID, const std::string& prefix, ParameterSet<IDType>& params) {
-            auto id = static_cast<IDType>(static_cast<int>(baseID) + offset);
-            params.add(ChoiceParam<IDType>{id, prefix + " " + name, choices, def});
-        });
-        return *this;
+    constexpr ParameterGroup& addChoice(int offset, std::string_view name, ChoiceList choices, int def) {
+        return addTemplate(ChoiceParam<IDType>{offsetID(offset), name, choices, def});
     }
 
     /**
@@ -111,11 +110,11 @@ class ParameterGroup {
      * @param params Parameter set to add to
      * @param instances List of {baseID, prefix} pairs
      */
-    void instantiate(ParameterSet<IDType>& params, const std::vector<Instance>& instances) const {
+    template <size_t Capacity>
+    constexpr void instantiate(ParameterSet<IDType, Capacity>& params,
+                               std::initializer_list<Instance> instances) const {
         for (const auto& inst : instances) {
-            for (const auto& generator : generators_) {
-                generator(inst.baseID, inst.prefix, params);
-            }
+            addInstance(params, inst.baseID, inst.prefix, 0);
         }
     }
 
@@ -127,23 +126,48 @@ class ParameterGroup {
      * @param prefix Name prefix (will append " 1", " 2", etc.)
      * @param stride ID stride between instances (default: # params in group)
      */
-    void instantiateSequential(
-        ParameterSet<IDType>& params, IDType baseID, int count, const std::string& prefix, int stride = -1) const {
+    template <size_t Capacity>
+    constexpr void instantiateSequential(ParameterSet<IDType, Capacity>& params,
+                                         IDType baseID,
+                                         int count,
+                                         std::string_view prefix,
+                                         int stride = -1) const {
         if (stride < 0) {
-            stride = static_cast<int>(generators_.size());
+            stride = static_cast<int>(numTemplates);
         }
 
-        std::vector<Instance> instances;
         for (int i = 0; i < count; ++i) {
             auto id = static_cast<IDType>(static_cast<int>(baseID) + (i * stride));
-            instances.push_back({id, prefix + " " + std::to_string(i + 1)});
+            addInstance(params, id, prefix, i + 1);
         }
-        instantiate(params, instances);
     }
 
   private:
-    using Generator = std::function<void(IDType, const std::string&, ParameterSet<IDType>&)>;
-    std::vector<Generator> generators_;
+    // Offset stored in the ID field until the group is instantiated
+    static constexpr IDType offsetID(int offset) { return static_cast<IDType>(offset); }
+
+    constexpr ParameterGroup& addTemplate(const ParamSpec<IDType>& spec) {
+        if (numTemplates == MaxSize) {
+            throw std::length_error("ParameterGroup capacity exceeded");
+        }
+        templates[numTemplates++] = spec;
+        return *this;
+    }
+
+    template <size_t Capacity>
+    constexpr void
+    addInstance(ParameterSet<IDType, Capacity>& params, IDType baseID, std::string_view prefix, int number) const {
+        for (size_t i = 0; i < numTemplates; ++i) {
+            auto spec = templates[i];
+            spec.id = static_cast<IDType>(static_cast<int>(baseID) + static_cast<int>(spec.id));
+            spec.prefix = prefix;
+            spec.instanceNumber = number;
+            params.add(spec);
+        }
+    }
+
+    std::array<ParamSpec<IDType>, MaxSize> templates{};
+    size_t numTemplates = 0;
 };
 
 } // namespace jnsc::juce_interface
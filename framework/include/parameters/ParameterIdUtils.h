@@ -5,6 +5,7 @@
 #pragma once
 
 #include <juce_core/juce_core.h>
+#include <string_view>
 #include <type_traits>
 
 namespace jnsc::juce_interface {
@@ -17,10 +18,64 @@ namespace jnsc::juce_interface {
  * This works for any enum class with underlying int values.
  */
 
+/// Prefix shared by all string parameter IDs
+inline constexpr const char* paramIdPrefix = "param_";
+inline constexpr int paramIdPrefixLength = 6;
+
 // Only enable idToString for enum types
 template <typename EnumType, std::enable_if_t<std::is_enum_v<EnumType>, int> = 0>
 inline juce::String idToString(EnumType id) {
-    return "param_" + juce::String(static_cast<int>(id));
+    return paramIdPrefix + juce::String(static_cast<int>(id));
+}
+
+/**
+ * @brief Converts a string parameter ID back to its enum index (inverse of idToString)
+ *
+ * The numeric suffix is the index itself, so this acts as a perfect hash:
+ * no tables, no allocation, just a walk over the few digits after the prefix.
+ *
+ * @param parameterID String ID (e.g., "param_3")
+ * @return Enum index, or -1 if the string is not a valid parameter ID
+ */
+inline int stringToIndex(const juce::String& parameterID) {
+    if (!parameterID.startsWith(paramIdPrefix) || parameterID.length() == paramIdPrefixLength)
+        return -1;
+
+    int index = 0;
+    auto ptr = parameterID.getCharPointer() + paramIdPrefixLength;
+    for (auto c = *ptr; c != 0; c = *++ptr) {
+        if (c < '0' || c > '9' || index > 99999)
+            return -1;
+        index = index * 10 + static_cast<int>(c - '0');
+    }
+    return index;
+}
+
+/**
+ * @brief Converts a string view from a parameter description to a juce::String
+ * @param text UTF-8 text
+ */
+inline juce::String toJuceString(std::string_view text) {
+    return juce::String::fromUTF8(text.data(), static_cast<int>(text.size()));
+}
+
+/**
+ * @brief Builds a parameter display name from its group prefix and instance number
+ *
+ * Usage: displayName("Band", 2, "Gain") -> "Band 2 Gain", displayName("", 0, "Gain") -> "Gain"
+ *
+ * @param prefix Group instance prefix (may be empty)
+ * @param instanceNumber Instance number appended to the prefix (0 = none)
+ * @param name Parameter name
+ */
+inline juce::String displayName(std::string_view prefix, int instanceNumber, std::string_view name) {
+    if (prefix.empty())
+        return toJuceString(name);
+
+    auto result = toJuceString(prefix);
+    if (instanceNumber > 0)
+        result += " " + juce::String(instanceNumber);
+    return result + " " + toJuceString(name);
 }
 
 } // namespace jnsc::juce_interface
@@ -0,0 +1,115 @@
+// Jonssonic Plugin Framework
+// Parameter mailbox - coalescing lock-free parameter transport
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Coalescing single-slot-per-parameter mailbox
+ *
+ * Each parameter owns one atomic value slot and one bit in an atomic dirty mask.
+ * Writers (message thread, host automation thread) store the latest value and
+ * set the bit; the audio thread atomically grabs the mask and visits only the
+ * set bits. Last value wins, so bursts can never overflow and each parameter is
+ * delivered at most once per drain.
+ *
+ * Example usage:
+ * @code
+ *   ParameterMailbox<64> mailbox;
+ *
+ *   // Any thread:
+ *   mailbox.post(index, value);
+ *
+ *   // Audio thread (once per block):
+ *   mailbox.drain([](size_t index, float value) { ... });
+ * @endcode
+ *
+ * @tparam NumSlots Number of parameter slots
+ */
+template <size_t NumSlots>
+class ParameterMailbox {
+  public:
+    /// Default constructor
+    ParameterMailbox() {
+        for (auto& value : values)
+            value.store(0.0f, std::memory_order_relaxed);
+        for (auto& word : dirty)
+            word.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Post the latest value for a slot (wait-free, any thread)
+     * @param index Slot index [0, NumSlots)
+     * @param value New value (overwrites any value not yet drained)
+     * @return True if a value not yet drained was overwritten (coalesced)
+     */
+    bool post(size_t index, float value) noexcept {
+        const uint64_t bit = uint64_t{1} << (index % bitsPerWord);
+        values[index].store(value, std::memory_order_relaxed);
+        return (dirty[index / bitsPerWord].fetch_or(bit, std::memory_order_release) & bit) != 0;
+    }
+
+    /**
+     * @brief Visit every slot posted since the last drain (audio thread)
+     * @param handler Callable invoked as handler(size_t index, float value)
+     */
+    template <typename Handler>
+    void drain(Handler&& handler) noexcept {
+        for (size_t word = 0; word < numWords; ++word) {
+            auto bits = dirty[word].exchange(0, std::memory_order_acquire);
+            while (bits != 0) {
+                const size_t index = word * bitsPerWord + countTrailingZeros(bits);
+                bits &= bits - 1; // Clear lowest set bit
+                handler(index, values[index].load(std::memory_order_relaxed));
+            }
+        }
+    }
+
+    /**
+     * @brief Check if any slot is waiting to be drained
+     * @return True if at least one dirty bit is set
+     */
+    bool hasPending() const noexcept {
+        for (const auto& word : dirty) {
+            if (word.load(std::memory_order_acquire) != 0)
+                return true;
+        }
+        return false;
+    }
+
+    /// Drop all pending changes without delivering them
+    void clear() noexcept {
+        for (auto& word : dirty)
+            word.store(0, std::memory_order_release);
+    }
+
+  private:
+    static constexpr size_t bitsPerWord = 64;
+    static constexpr size_t numWords = (NumSlots + bitsPerWord - 1) / bitsPerWord;
+
+    static size_t countTrailingZeros(uint64_t bits) noexcept {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<size_t>(index);
+#else
+        return static_cast<size_t>(__builtin_ctzll(bits));
+#endif
+    }
+
+    std::array<std::atomic<float>, NumSlots> values;
+    std::array<std::atomic<uint64_t>, numWords> dirty;
+};
+
+} // namespace jnsc::juce_interface
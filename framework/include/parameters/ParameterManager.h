@@ -1,20 +1,36 @@
 // Jonssonic Plugin Framework
-// Parameter manager with lock-free FIFO and APVTS integration
+// Parameter manager with lock-free mailbox and APVTS integration
 // Design inspired by mrta_utils from João Rossi's Modern Real-Time Audio (2025)
 // https://github.com/joaorossi/modern-real-time-audio-2025/tree/main/modules/mrta_utils
 // SPDX-License-Identifier: MIT
 
 #pragma once
 
+#include "AutomationRecorder.h"
+#include "ParameterEventQueue.h"
 #include "ParameterIdUtils.h"
+#include "DerivedValueGraph.h"
+#include "HostNotificationThrottle.h"
+#include "MidiLearn.h"
+#include "ModulationMatrix.h"
+#include "ParamFrame.h"
+#include "ParameterMailbox.h"
+#include "ParameterMorph.h"
 #include "ParameterSet.h"
+#include "ParameterSmoother.h"
+#include "ParameterTelemetry.h"
+#include "SnapshotExchange.h"
+#include "StateFormat.h"
+#include "UndoHistory.h"
 #include <juce_audio_processors/juce_audio_processors.h>
 
+#include <algorithm>
+#include <array>
+#include <bitset>
 #include <functional>
 #include <juce_data_structures/juce_data_structures.h>
 #include <memory>
 #include <sstream>
-#include <unordered_map>
 
 #include <vector>
 
@@ -25,24 +41,63 @@ namespace jnsc::juce_interface {
  *
  * Features:
  * - Wraps JUCE AudioProcessorValueTreeState
- * - Lock-free FIFO for GUI → Audio thread communication
+ * - Dense enum-indexed parameter table (no hashing on lookups)
+ * - Coalescing lock-free mailbox for GUI/host → Audio thread communication
+ * - Sample-accurate timestamped events via sub-block splitting
+ * - Optional fixed internal block size, independent of the host block size
+ * - Framework-owned block-based smoothing for FloatParams that declare a smoothing time
  * - Event-based callbacks for parameter changes
- * - Automatic state save/load
+ * - Pull-model ParamFrame of native values with a changed mask (no callbacks needed)
+ * - Lazy derived values rebuilt at most once per (sub-)block
+ * - Gesture-coalesced undo/redo with bounded memory
+ * - Automation capture for offline replay (see AutomationPlayer)
+ * - Relaxed telemetry counters for parameter traffic and cost
+ * - Optional rate-limited host notification for GUI-driven changes
+ * - Compact versioned binary state with XML fallback and schema migrations
+ * - Lock-free state snapshots applied by the audio thread at the next block boundary
+ * - A/B(/C/D) snapshot morphing computed on the audio thread in one dense pass
+ * - Optional control-rate modulation matrix applied on top of host values
+ * - MIDI CC learn with sample-accurate CC events
  *
  * Usage:
- *   ParameterManager<ParamID> paramManager(createParams(), processor);
+ *   static constexpr auto parameters = MyParams::createParams(); // Built at compile time
+ *   ParameterManager<ParamID> paramManager(parameters, processor);
  *   paramManager.on(ParamID::Rate, [](float v, bool skip) { flanger.setRate(v, skip); });
  *
  *   // In processBlock:
- *   paramManager.update();  // Pulls from FIFO, triggers callbacks
+ *   paramManager.update(); // Drains mailbox, triggers callbacks
+ *
+ *   // Or, for sample-accurate events (calls update() first):
+ *   paramManager.processSubBlocks(numSamples, [&](int start, int length) { ... });
+ *
+ *   // Pull model: read values instead of registering callbacks (see ParamFrame)
+ *   const auto& frame = paramManager.getFrame();
+ *   if (frame.hasChanged(ParamID::Rate))
+ *       flanger.setRate(frame[ParamID::Rate], frame.shouldSkipSmoothing(ParamID::Rate));
+ *
+ * @tparam IDType Parameter ID enum (values must be contiguous from 0)
+ * @tparam MaxParams Compile-time capacity of the parameter table
  */
 
 // ==============================================================================
 // ParameterManager class
 // ==============================================================================
-template <typename IDType>
-class ParameterManager : public juce::AudioProcessorValueTreeState::Listener {
+template <typename IDType, size_t MaxParams = 64>
+class ParameterManager : public juce::AudioProcessorValueTreeState::Listener,
+                         private juce::AudioProcessorParameter::Listener {
   public:
+    /// Parameter ID enum
+    using ID = IDType;
+
+    /// Capacity of the enum-indexed parameter table
+    static constexpr size_t maxParameters = MaxParams;
+
+    /// Maximum number of morph snapshots
+    static constexpr size_t maxMorphSnapshots = 4;
+
+    /// Sub-block length while framework smoothing is ramping (callbacks get a new value at this rate)
+    static constexpr int smoothingBlockSize = 32;
+
     /**
      * @brief Callback type for parameter changes
      * @param value New normalized value [0, 1]
@@ -52,10 +107,11 @@ class ParameterManager : public juce::AudioProcessorValueTreeState::Listener {
 
     /**
      * @brief Construct parameter manager
-     * @param params Parameter definitions
+     * @param params Parameter definitions (typically a constexpr ParameterSet)
      * @param processor Audio processor instance
      */
-    ParameterManager(const ParameterSet<IDType>& params, juce::AudioProcessor& processor);
+    template <size_t Capacity>
+    ParameterManager(const ParameterSet<IDType, Capacity>& params, juce::AudioProcessor& processor);
 
     /**
      * @brief Destructor
@@ -70,13 +126,142 @@ class ParameterManager : public juce::AudioProcessorValueTreeState::Listener {
     void on(IDType id, Callback callback);
 
     /**
-     * @brief Update parameters from FIFO (call once per processBlock)
+     * @brief Prepare framework smoothing (call in prepareToPlay, before syncAll)
+     * @param sampleRate Sample rate in Hz
+     */
+    void prepare(double sampleRate);
+
+    /**
+     * @brief Update parameters from mailbox (call once per processBlock)
      *
-     * Pulls pending parameter changes from the lock-free FIFO and
-     * triggers registered callbacks on the audio thread.
+     * Drains parameters changed since the last call and triggers their
+     * registered callbacks on the audio thread, at most once per parameter
+     * with the latest value. Framework-smoothed parameters only ramp inside
+     * processSubBlocks(); here they jump to the new value. Queued timestamped
+     * events (pushEvent(), processMidi()) are applied at the start of the
+     * block; processSubBlocks() applies them at their sample offsets.
      */
     void update();
 
+    /**
+     * @brief Queue a timestamped parameter change (audio thread only)
+     *
+     * The change is applied by processSubBlocks() at the given sample offset of
+     * the current block, splitting the block there (update() applies it at the
+     * start of the block). Use for sources that carry sample positions (e.g.,
+     * MIDI, recorded automation).
+     *
+     * @param id Parameter ID
+     * @param value New value in native range
+     * @param sampleOffset Sample offset within the current block
+     * @return False if the event queue is full (event dropped)
+     */
+    bool pushEvent(IDType id, float value, int sampleOffset);
+
+    /**
+     * @brief Post an untimestamped change as if the host had sent it (any thread)
+     *
+     * Goes through the mailbox like GUI and host automation changes, without
+     * touching the APVTS parameter. Used by AutomationPlayer for replay.
+     *
+     * @param id Parameter ID
+     * @param value New value in native range
+     */
+    void postValue(IDType id, float value) { postToMailbox(toIndex(id), value); }
+
+    /**
+     * @brief Turn mapped MIDI CC messages into timestamped events (audio thread)
+     *
+     * Call before processSubBlocks() or update(). Each CC costs one routing
+     * table lookup and is applied at its sample position (at the block start
+     * with update()); the host value is not changed.
+     *
+     * @param midiMessages MIDI buffer of the current block
+     */
+    void processMidi(const juce::MidiBuffer& midiMessages);
+
+    /**
+     * @brief Get the MIDI learn routing (message thread: map, learn and commit)
+     */
+    MidiLearn<MaxParams>& getMidiLearn() { return midiLearn; }
+
+    /**
+     * @brief Process a block in sub-blocks split at timestamped parameter events
+     *
+     * Drains the mailbox first, then invokes process(startSample, numSamples) for
+     * each sub-range, applying queued events at their sample offsets in between.
+     * Events closer than the minimum sub-block size to the previous split are
+     * deferred to the next split, so a block is split at most
+     * numSamples / minSubBlockSize times.
+     *
+     * While a framework-smoothed parameter is ramping, sub-blocks are at most
+     * smoothingBlockSize long; its callback receives the ramp value at the end of
+     * each sub-block (skipSmoothing = true) and getRamp() exposes the per-sample ramp.
+     *
+     * With a maximum sub-block size set, the block is also split on a fixed
+     * grid of that size, so the DSP sees the same chunk length (and can be
+     * prepared for it) however many samples the host passes.
+     *
+     * @param numSamples Number of samples in the current block
+     * @param process Callable invoked as process(int startSample, int numSamples)
+     */
+    template <typename ProcessFn>
+    void processSubBlocks(int numSamples, ProcessFn&& process);
+
+    /**
+     * @brief Process a block in sub-blocks, feeding its input to the modulation envelope follower
+     *
+     * Same as processSubBlocks(numSamples, process), with the input of each
+     * sub-block passed to the attached modulation matrix before its control
+     * tick. Use for in-place processing, before the sub-block is overwritten.
+     *
+     * @param buffer Host buffer (float or double), input in the first numInputChannels
+     * @param numInputChannels Number of input channels
+     * @param process Callable invoked as process(int startSample, int numSamples)
+     */
+    template <typename SampleType, typename ProcessFn>
+    void processSubBlocks(const juce::AudioBuffer<SampleType>& buffer, int numInputChannels, ProcessFn&& process);
+
+    /**
+     * @brief Get the per-sample ramp of a framework-smoothed parameter
+     *
+     * Only valid inside the process callback of processSubBlocks(); index 0 is the
+     * first sample of the current sub-block.
+     *
+     * @param id Parameter ID
+     * @return Ramp values in native range, or nullptr if the value is steady
+     */
+    const float* getRamp(IDType id) const;
+
+    /**
+     * @brief Get the native values and change flags of the current (sub-)block
+     *
+     * Valid after update() and inside the process callback of processSubBlocks().
+     * Each frame flags the parameters changed since the previous frame, including
+     * changes from syncAll() and loaded states; read it once per (sub-)block.
+     */
+    const ParamFrame<IDType, MaxParams>& getFrame() const { return frame; }
+
+    /**
+     * @brief Set the minimum sub-block length used by processSubBlocks()
+     * @param numSamples Minimum number of samples per sub-block (default 32)
+     */
+    void setMinSubBlockSize(int numSamples) { minSubBlockSize = std::max(1, numSamples); }
+
+    /**
+     * @brief Set the fixed internal block size used by processSubBlocks()
+     *
+     * Host blocks are processed in chunks of at most this length, with the
+     * parameter frame, smoothing and callbacks updated per chunk. DSP prepared
+     * for this block size is then safe with any host buffer length.
+     *
+     * @param numSamples Maximum number of samples per sub-block (0 = host block length, default)
+     */
+    void setMaxSubBlockSize(int numSamples) { maxSubBlockSize = std::max(0, numSamples); }
+
+    /// Get the fixed internal block size (0 = host block length)
+    int getMaxSubBlockSize() const { return maxSubBlockSize; }
+
     /**
      * @brief Sync all parameters to DSP (call in prepareToPlay)
      *
@@ -103,25 +288,206 @@ class ParameterManager : public juce::AudioProcessorValueTreeState::Listener {
     float getNativeValue(IDType id) const;
 
     /**
-     * @brief Set parameter value (thread-safe, from GUI)
+     * @brief Set parameter value (message thread, from GUI)
+     *
+     * With a host notification rate set, the audio thread still receives the
+     * value immediately, while the host is notified at the throttled rate.
+     * Until then the APVTS parameter lags behind; getValue(), getNativeValue(),
+     * saveState() and morph snapshots read the new value, and the host
+     * notification is not delivered to the DSP a second time. Host automation
+     * arriving in the meantime takes over from the pending GUI value.
+     *
      * @param id Parameter ID
      * @param value Normalized value [0, 1]
      */
     void setValue(IDType id, float value);
 
     /**
-     * @brief Save plugin state to memory block
+     * @brief Limit how often setValue() notifies the host (message thread)
+     *
+     * Coalesces fast GUI changes (e.g., knob drags) to at most hz host
+     * notifications per second per parameter, wrapped in change gestures,
+     * and always sends the final value. Off (0) by default.
+     *
+     * @param hz Notification rate in Hz (0 = notify on every change)
+     */
+    void setHostNotificationRate(float hz) { hostThrottle.setRate(hz); }
+
+    /// Begin a change gesture for setValue() calls, e.g., on mouse down (message thread)
+    void beginGesture(IDType id) { hostThrottle.beginGesture(toIndex(id)); }
+
+    /// End a change gesture, sending the final value to the host first (message thread)
+    void endGesture(IDType id) { hostThrottle.endGesture(toIndex(id)); }
+
+    /**
+     * @brief Set the parameter schema version and migration steps (call in constructor)
+     *
+     * Bump the version whenever parameter enum values are renumbered or removed,
+     * and add a migration step for each affected ID. Legacy XML states are
+     * treated as schema version 1.
+     *
+     * @param version Current schema version (default 1)
+     * @param migrationSteps Steps ordered by schema version
+     */
+    void setStateSchema(int version, std::vector<StateMigration> migrationSteps = {});
+
+    /**
+     * @brief Save plugin state to memory block (compact binary format)
      * @param destData Destination memory block
      */
     void saveState(juce::MemoryBlock& destData) const;
 
     /**
-     * @brief Load plugin state from memory block
+     * @brief Load plugin state from memory block (message thread)
+     *
+     * Reads the binary format directly; falls back to XML for older sessions.
+     * Parameters missing from the state are reset to their defaults.
+     *
+     * No callbacks run on the calling thread: the loaded values are published
+     * as an immutable snapshot that the audio thread applies at the start of
+     * the next update() or processSubBlocks(). The host notifications sent
+     * afterwards are not posted to the mailbox again, so each value is
+     * delivered once (host automation arriving during the load is dropped, as
+     * are GUI values the host notification throttle has not sent yet).
+     *
      * @param data Source data
      * @param sizeInBytes Size of data
      */
     void loadState(const void* data, int sizeInBytes);
 
+    /**
+     * @brief Choose how the audio thread applies a loaded state
+     * @param shouldCrossfade If true, loaded values glide like automation (DSP and
+     * framework smoothing); if false (default), they are applied instantly
+     */
+    void setStateCrossfade(bool shouldCrossfade) { stateCrossfade.store(shouldCrossfade, std::memory_order_relaxed); }
+
+    /**
+     * @brief Attach a modulation matrix (call in the processor constructor)
+     *
+     * processSubBlocks() ticks the matrix once per control block and applies
+     * its offsets on top of the host value of every routed parameter. The
+     * modulated value only reaches the DSP callbacks; the host value is left
+     * unchanged. The envelope follower source reads the input passed to
+     * processSubBlocks(buffer, numInputChannels, process).
+     *
+     * @param matrix Modulation matrix owned by the processor (nullptr to detach)
+     */
+    void setModulation(ModulationMatrix<MaxParams>* matrix) { modulation = matrix; }
+
+    /**
+     * @brief Attach a derived value graph (call in the processor constructor)
+     *
+     * Every value delivered to the DSP marks its dependent nodes dirty; dirty
+     * nodes are rebuilt once before the block (update()) or before each
+     * sub-block (processSubBlocks()), so timestamped events and ramps reach
+     * derived values at the sample they apply.
+     *
+     * @param graph Derived value graph owned by the processor (nullptr to detach)
+     */
+    void setDerivedValues(DerivedValueGraph<MaxParams>* graph) { derived = graph; }
+
+    /**
+     * @brief Capture the current parameter values as a morph snapshot (message thread)
+     * @param slot Snapshot slot [0, maxMorphSnapshots); slots up to this one become morph targets
+     */
+    void captureMorphSnapshot(size_t slot);
+
+    /// Remove all morph snapshots (message thread)
+    void clearMorphSnapshots();
+
+    /**
+     * @brief Set the morph position (any thread)
+     *
+     * Position 0 is the first snapshot, 1 the second, and so on. Applied by the
+     * audio thread at the next block while morphing is enabled.
+     *
+     * @param position Morph position in [0, number of snapshots - 1]
+     */
+    void setMorphPosition(float position) { morphPosition.store(position, std::memory_order_relaxed); }
+
+    /**
+     * @brief Enable or disable morphing (any thread)
+     *
+     * While enabled and at least two snapshots exist, the morph drives the DSP
+     * callbacks whenever the position moves; host and GUI values are not
+     * changed, and their changes do not reach the DSP while the morph is
+     * engaged. Modulation applies on top of the morphed values. Disabling
+     * restores the current APVTS values.
+     *
+     * @param shouldMorph True to enable morphing
+     */
+    void setMorphEnabled(bool shouldMorph) { morphEnabled.store(shouldMorph, std::memory_order_relaxed); }
+
+    /**
+     * @brief Set where discrete parameters switch between two snapshots
+     * @param threshold Fraction between neighbouring snapshots (default 0.5)
+     */
+    void setMorphSwitchThreshold(float threshold) { morphThreshold.store(threshold, std::memory_order_relaxed); }
+
+    /**
+     * @brief Revert the last undo step (message thread)
+     *
+     * A step is one change gesture (e.g., a whole slider drag), one setValue()
+     * call, or everything recorded inside an undo transaction. The old values
+     * are replayed through the normal parameter path, so the host sees them.
+     *
+     * @return False if there was nothing to undo
+     */
+    bool undo();
+
+    /**
+     * @brief Re-apply the last undone step (message thread)
+     * @return False if there was nothing to redo
+     */
+    bool redo();
+
+    /// Check if there is a step to undo
+    bool canUndo() const { return undoHistory.canUndo(); }
+
+    /// Check if there is a step to redo
+    bool canRedo() const { return undoHistory.canRedo(); }
+
+    /**
+     * @brief Get the undo history (message thread)
+     *
+     * Use beginTransaction()/endTransaction() to group several changes into
+     * one step (e.g., around a preset load), or clear() to forget the history.
+     */
+    UndoHistory<>& getUndoHistory() { return undoHistory; }
+
+    /**
+     * @brief Start capturing parameter events to a file (message thread)
+     *
+     * Records every change reaching the audio thread with its block index and
+     * sample offset: mailbox changes (GUI, host automation), timestamped events
+     * and MIDI CC. Replay the file offline with AutomationPlayer.
+     *
+     * @param file Destination file (replaced if it exists)
+     * @return False if the file could not be opened
+     */
+    bool startAutomationRecording(const juce::File& file) { return automationRecorder.start(file); }
+
+    /// Stop capturing and close the file (message thread)
+    void stopAutomationRecording() { automationRecorder.stop(); }
+
+    /// Check if parameter events are being captured
+    bool isRecordingAutomation() const { return automationRecorder.isRecording(); }
+
+    /**
+     * @brief Read the parameter-path telemetry (any thread)
+     *
+     * Reports changes enqueued, coalesced in the mailbox and dropped by the
+     * full event queue, the event queue high-water mark, callbacks per block
+     * and the cycles spent on parameter work per block (update(), or the
+     * parameter handling of processSubBlocks() excluding the process callback).
+     * Counters are relaxed atomics: cheap to keep, safe to log from any thread.
+     */
+    ParameterTelemetry::Snapshot getTelemetry() const { return telemetry.getSnapshot(); }
+
+    /// Reset the telemetry counters (any thread)
+    void resetTelemetry() { telemetry.reset(); }
+
     /**
      * @brief Get underlying APVTS (for GUI attachments)
      */
@@ -129,247 +495,883 @@ class ParameterManager : public juce::AudioProcessorValueTreeState::Listener {
     const juce::AudioProcessorValueTreeState& getAPVTS() const { return *apvts; }
 
   private:
-    // Store parameter IDs for listener management
-    std::vector<juce::String> registeredParamIDs;
+    // Sub-block length while modulation is active: one control tick, short enough for the ramps it starts
+    static constexpr int modulationBlockSize =
+        std::min(ModulationMatrix<MaxParams>::controlBlockSize, smoothingBlockSize);
 
-    // Struct for parameter change events
-    struct ParameterChange {
-        IDType id;
-        float value;
+    // Entry in the dense parameter table (indexed by enum value)
+    struct ParameterEntry {
+        juce::RangedAudioParameter* parameter = nullptr; // APVTS parameter (nullptr if unused slot)
+        Callback callback;                               // Registered callback (may be empty)
+        juce::String paramID;                                   // Precomputed string ID (e.g., "param_3")
+        ParameterSmoother smoother;                             // Framework smoother (used if rampSlot >= 0)
+        float smoothingMs = 0.0f;                               // Declared smoothing time
+        SmoothingCurve smoothingCurve = SmoothingCurve::Linear; // Declared smoothing curve
+        int rampSlot = -1;                                      // Slot in rampStorage, -1 if not smoothed
+        bool rampActive = false;                                // True if the current sub-block ramp is valid
+        bool modulationActive = false;                          // True while the modulation matrix drives it
+        float modulatedValue = 0.0f;                            // Last native value sent by the modulation
     };
 
     // Create APVTS from ParameterSet
-    void createAPVTS(const ParameterSet<IDType>& params, juce::AudioProcessor& processor);
+    template <size_t Capacity>
+    void createAPVTS(const ParameterSet<IDType, Capacity>& params, juce::AudioProcessor& processor);
 
     // AudioProcessorValueTreeState::Listener override
     void parameterChanged(const juce::String& parameterID, float newValue) override;
 
-    // Create JUCE parameter from ParamVariant
-    std::unique_ptr<juce::RangedAudioParameter>
-    createJuceParameter(const typename ParameterSet<IDType>::ParamVariant& param);
+    // AudioProcessorParameter::Listener overrides (gestures feed the undo history)
+    void parameterValueChanged(int, float) override {}
+    void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override;
+
+    // Post a change to the mailbox and count it
+    void postToMailbox(size_t index, float value);
+
+    // Queue a timestamped event and count it, or the drop
+    bool queueEvent(const ParameterEvent& event);
+
+    // Replay undo/redo values through the host-visible parameter path
+    void replayHistoryValue(size_t index, float value);
+
+    // Enum ID to table index
+    static size_t toIndex(IDType id) { return static_cast<size_t>(id); }
 
-    std::unique_ptr<juce::AudioProcessorValueTreeState> apvts;            // Underlying APVTS
-    juce::AbstractFifo fifo{128};                                         // Lock-free FIFO for parameter changes
-    std::vector<ParameterChange> fifoBuffer;                              // FIFO buffer
-    std::unordered_map<IDType, Callback> callbacks;                       // Registered callbacks
-    std::unordered_map<IDType, juce::RangedAudioParameter*> parameterMap; // ID to parameter map
+    // Normalized value of a parameter, including a value the throttle has not sent to the host yet
+    float currentValue(size_t index) const;
+
+    // Route a new value to the smoother or straight to the callback
+    void applyChange(size_t index, float value, bool smooth);
+
+    // Apply a state snapshot published by loadState() (audio thread)
+    void applyPendingState();
+
+    // Apply modulation offsets on top of host values (audio thread)
+    void applyModulation();
+
+    // Apply the morph if its position or snapshots changed (audio thread)
+    void applyMorph(bool smooth);
+
+    // Drain the mailbox into applyChange()
+    void drainMailbox(bool smooth);
+
+    // Check if any framework smoother is ramping
+    bool isAnySmoothing() const;
+
+    // Sub-block loop of processSubBlocks(); feedInput(start, length) runs before each control tick
+    template <typename InputFn, typename ProcessFn>
+    void runSubBlocks(int numSamples, InputFn&& feedInput, ProcessFn&& process);
+
+    // Produce the next numSamples ramp values and notify callbacks
+    void advanceSmoothers(int numSamples);
+
+    // Hand a value to the DSP: record it for the next frame and invoke the callback
+    void deliver(size_t index, float value, bool skipSmoothing);
+
+    // Move the changes recorded since the previous frame into the frame
+    void publishFrame();
+
+    // Morph engine for this parameter table
+    using Morph = ParameterMorph<MaxParams, maxMorphSnapshots>;
+    using MorphSnapshots = typename Morph::Snapshots;
+
+    // Normalized values gathered while loading a state
+    using LoadedValues = std::array<float, MaxParams>;
+
+    // Parse a binary state chunk (data must start with the magic)
+    bool readBinaryState(const void* data, int sizeInBytes, LoadedValues& loaded) const;
+
+    // Parse a legacy XML state chunk
+    bool readXmlState(const void* data, int sizeInBytes, LoadedValues& loaded) const;
+
+    // Migrate a saved ID and store its value if the parameter still exists
+    void storeLoadedValue(int id, float nativeValue, int savedSchema, LoadedValues& loaded) const;
+
+    // Create JUCE parameter from ParamSpec
+    static std::unique_ptr<juce::RangedAudioParameter> createJuceParameter(const ParamSpec<IDType>& spec);
+
+    std::unique_ptr<juce::AudioProcessorValueTreeState> apvts;     // Underlying APVTS
+    ParameterMailbox<MaxParams> mailbox;                           // Latest pending value per parameter
+    ParameterEventQueue<256> events;                               // Timestamped events for the current block
+    int minSubBlockSize = 32;                                      // Minimum sub-block length in samples
+    int maxSubBlockSize = 0;                                       // Fixed internal block length (0 = host block)
+    std::array<size_t, MaxParams> smoothedIndices{};               // Table indices of framework-smoothed params
+    size_t numSmoothed = 0;                                        // Number of framework-smoothed params
+    std::array<float, MaxParams * smoothingBlockSize> rampStorage; // smoothingBlockSize floats per smoothed param
+    int schemaVersion = 1;                                         // Parameter schema version written to state
+    std::vector<StateMigration> migrations;                        // Steps mapping older schemas to the current one
+    SnapshotExchange<std::array<float, MaxParams>> stateSnapshots; // Loaded native values for the audio thread
+    std::atomic<bool> stateCrossfade{false};                       // Glide to loaded values instead of jumping
+    std::atomic<bool> loadingState{false};                         // loadState() is notifying the host
+    Morph morph;                                                   // Dense morph interpolation (audio thread)
+    MorphSnapshots morphEditSet;                                   // Captured snapshots (message thread)
+    SnapshotExchange<MorphSnapshots> morphSnapshots;               // Captured snapshots handed to the audio thread
+    const MorphSnapshots* morphActiveSet = nullptr;                // Snapshots in use by the audio thread
+    std::atomic<float> morphPosition{0.0f};                        // Requested morph position
+    std::atomic<float> morphThreshold{0.5f};                       // Discrete switch point
+    std::atomic<bool> morphEnabled{false};                         // Morph drives the DSP callbacks
+    float appliedMorphPosition = -1.0f;                            // Last applied position (-1 = not morphing)
+    std::array<float, MaxParams> morphedValues{};                  // Last native values sent by the morph
+    ModulationMatrix<MaxParams>* modulation = nullptr;             // Attached modulation matrix (optional)
+    bool anyModulationActive = false;                              // Some parameter was modulated at the last tick
+    DerivedValueGraph<MaxParams>* derived = nullptr;               // Attached derived value graph (optional)
+    MidiLearn<MaxParams> midiLearn;                                // MIDI CC routing
+    HostNotificationThrottle<MaxParams> hostThrottle;              // Rate-limited host notification (optional)
+    std::array<std::atomic<float>, MaxParams> throttledValues;     // Values awaiting the throttle (< 0 = none)
+    std::atomic<int> throttleEcho{-1};                             // Slot the throttle is notifying (-1 = none)
+    ParameterTelemetry telemetry;                                  // Parameter-path counters
+    AutomationRecorder automationRecorder;                         // Parameter event capture (optional)
+    UndoHistory<> undoHistory;                                     // Gesture-coalesced parameter deltas
+    std::array<float, MaxParams> gestureStartValues{};             // Normalized values when gestures began
+    bool replayingHistory = false;                                 // Suppresses recording during undo/redo
+    ParamFrame<IDType, MaxParams> frame;                           // Values and change flags of the current block
+    std::bitset<MaxParams> pendingChanged;                         // Changed since the last published frame
+    std::bitset<MaxParams> pendingJumped;                          // Of those, changes that skip DSP smoothing
+    std::array<ParameterEntry, MaxParams> parameterTable;          // Enum-indexed parameters and callbacks
 };
 
 //==============================================================================
 // Implementation
 //==============================================================================
 
-template <typename IDType>
-ParameterManager<IDType>::ParameterManager(const ParameterSet<IDType>& params, juce::AudioProcessor& processor) {
-    fifoBuffer.resize(128);
+template <typename IDType, size_t MaxParams>
+template <size_t Capacity>
+ParameterManager<IDType, MaxParams>::ParameterManager(const ParameterSet<IDType, Capacity>& params,
+                                                      juce::AudioProcessor& processor) {
+    jassert(params.size() <= MaxParams); // Increase MaxParams for larger parameter sets
     createAPVTS(params, processor);
 
-    // Register as listener for all parameters
-    for (auto* param : apvts->processor.getParameters()) {
-        if (auto* paramWithID = dynamic_cast<juce::AudioProcessorParameterWithID*>(param)) {
-            apvts->addParameterListener(paramWithID->paramID, this);
-            registeredParamIDs.push_back(paramWithID->paramID);
+    // Register as listener for all parameters (values via the APVTS, gestures for undo)
+    for (const auto& entry : parameterTable) {
+        if (entry.parameter != nullptr) {
+            apvts->addParameterListener(entry.paramID, this);
+            entry.parameter->addListener(this);
         }
     }
+    for (size_t i = 0; i < MaxParams; ++i) {
+        hostThrottle.attach(i, parameterTable[i].parameter);
+        throttledValues[i].store(-1.0f, std::memory_order_relaxed);
+    }
+
+    // Once the throttle has notified the host, the APVTS holds the value (even if the host
+    // suppressed an unchanged value's listener call); its echo was already posted by setValue()
+    hostThrottle.setSendFunction([this](size_t index, float value) {
+        throttleEcho.store(static_cast<int>(index), std::memory_order_release);
+        parameterTable[index].parameter->setValueNotifyingHost(value);
+        throttleEcho.store(-1, std::memory_order_release);
+        throttledValues[index].store(-1.0f, std::memory_order_release);
+    });
 }
 
 // Unregister listeners in destructor
-template <typename IDType>
-ParameterManager<IDType>::~ParameterManager() {
+template <typename IDType, size_t MaxParams>
+ParameterManager<IDType, MaxParams>::~ParameterManager() {
+    hostThrottle.flushAll(); // Final values reach the host and the undo history
     if (apvts) {
-        for (const auto& paramID : registeredParamIDs) {
-            apvts->removeParameterListener(paramID, this);
+        for (const auto& entry : parameterTable) {
+            if (entry.parameter != nullptr) {
+                apvts->removeParameterListener(entry.paramID, this);
+                entry.parameter->removeListener(this);
+            }
         }
     }
 }
-// Listener callback: push changes into FIFO for audio thread
-template <typename IDType>
-void ParameterManager<IDType>::parameterChanged(const juce::String& parameterID, float newValue) {
-    // Find enum ID from string
-    for (const auto& [id, param] : parameterMap) {
-        if (param->paramID == parameterID) {
-            int start1, size1, start2, size2;
-            fifo.prepareToWrite(1, start1, size1, start2, size2);
-            if (size1 > 0) {
-                fifoBuffer[static_cast<size_t>(start1)] = {id, newValue};
-                fifo.finishedWrite(1);
-            }
-            break;
+// Listener callback: post changes to mailbox for audio thread
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::parameterChanged(const juce::String& parameterID, float newValue) {
+    // Resolve enum ID from string in O(1) (numeric suffix is the table index)
+    const int index = stringToIndex(parameterID);
+    if (index < 0 || static_cast<size_t>(index) >= MaxParams)
+        return;
+
+    const auto& entry = parameterTable[static_cast<size_t>(index)];
+    if (entry.parameter == nullptr || entry.paramID != parameterID)
+        return;
+
+    // Values set by loadState() reach the audio thread through the state snapshot
+    if (loadingState.load(std::memory_order_acquire))
+        return;
+
+    // The throttle's host notification echoes a value setValue() already posted
+    if (throttleEcho.load(std::memory_order_acquire) == index)
+        return;
+
+    // Any other change (e.g., host automation) supersedes a value awaiting the throttle
+    throttledValues[static_cast<size_t>(index)].store(-1.0f, std::memory_order_release);
+    postToMailbox(static_cast<size_t>(index), newValue);
+}
+
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::postToMailbox(size_t index, float value) {
+    telemetry.countEnqueued();
+    if (mailbox.post(index, value))
+        telemetry.countCoalesced();
+}
+
+template <typename IDType, size_t MaxParams>
+bool ParameterManager<IDType, MaxParams>::queueEvent(const ParameterEvent& event) {
+    if (!events.push(event)) {
+        telemetry.countDropped();
+        return false;
+    }
+    telemetry.countEnqueued();
+    return true;
+}
+
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::on(IDType id, Callback callback) {
+    jassert(toIndex(id) < MaxParams);
+    parameterTable[toIndex(id)].callback = std::move(callback);
+}
+
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::prepare(double sampleRate) {
+    automationRecorder.setSampleRate(sampleRate);
+    for (size_t i = 0; i < numSmoothed; ++i) {
+        auto& entry = parameterTable[smoothedIndices[i]];
+        entry.smoother.prepare(sampleRate, entry.smoothingMs, entry.smoothingCurve);
+        entry.rampActive = false;
+    }
+}
+
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::update() {
+    telemetry.beginBlock();
+    automationRecorder.beginBlock(0); // Block length is unknown here
+    applyPendingState();
+    drainMailbox(false);
+
+    // Without sub-blocks, timestamped events take effect at the start of the block
+    const size_t numEvents = events.size();
+    for (size_t i = 0; i < numEvents; ++i) {
+        automationRecorder.record(events[i].index, events[i].value, 0);
+        applyChange(events[i].index, events[i].value, false);
+    }
+    events.clear();
+
+    applyMorph(false);
+    publishFrame();
+    if (derived != nullptr)
+        derived->evaluate();
+    telemetry.endBlock(numEvents);
+}
+
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::applyPendingState() {
+    const auto* snapshot = stateSnapshots.acquire();
+    if (snapshot == nullptr)
+        return;
+
+    const bool crossfade = stateCrossfade.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < MaxParams; ++i) {
+        auto& entry = parameterTable[i];
+        if (entry.parameter == nullptr)
+            continue;
+
+        const float value = (*snapshot)[i];
+        if (crossfade) {
+            applyChange(i, value, true);
+            continue;
         }
+
+        if (entry.rampSlot >= 0) {
+            entry.smoother.snapTo(value);
+        }
+        deliver(i, value, true); // Instant preset load
     }
 }
 
-template <typename IDType>
-void ParameterManager<IDType>::on(IDType id, Callback callback) {
-    callbacks[id] = std::move(callback);
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::applyModulation() {
+    anyModulationActive = false;
+    for (size_t i = 0; i < MaxParams; ++i) {
+        auto& entry = parameterTable[i];
+        const bool routed = modulation->isModulated(i);
+        if (entry.parameter == nullptr || (!routed && !entry.modulationActive))
+            continue;
+
+        // Offsets are normalized, so they follow the parameter's range and skew
+        const bool morphing = appliedMorphPosition >= 0.0f;
+        const float base = morphing ? entry.parameter->convertTo0to1(morphedValues[i]) : currentValue(i);
+        const float normalized = routed ? std::clamp(base + modulation->getOffset(i), 0.0f, 1.0f) : base;
+        const float value = entry.parameter->convertFrom0to1(normalized);
+
+        const bool wasActive = entry.modulationActive;
+        entry.modulationActive = routed;
+        anyModulationActive = anyModulationActive || routed;
+        if (wasActive && value == entry.modulatedValue)
+            continue;
+        entry.modulatedValue = value;
+        applyChange(i, value, true);
+    }
 }
 
-template <typename IDType>
-void ParameterManager<IDType>::update() {
-    const int numReady = fifo.getNumReady();
-    if (numReady == 0)
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::captureMorphSnapshot(size_t slot) {
+    jassert(slot < maxMorphSnapshots);
+    if (slot >= maxMorphSnapshots)
         return;
 
-    int start1, size1, start2, size2;
-    fifo.prepareToRead(numReady, start1, size1, start2, size2);
+    for (size_t i = 0; i < MaxParams; ++i) {
+        if (auto* param = parameterTable[i].parameter)
+            morphEditSet.values[slot][i] = currentValue(i);
+    }
+    morphEditSet.numSnapshots = std::max(morphEditSet.numSnapshots, slot + 1);
+
+    morphSnapshots.beginWrite() = morphEditSet;
+    morphSnapshots.publish();
+}
+
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::clearMorphSnapshots() {
+    morphEditSet.numSnapshots = 0;
+    morphSnapshots.beginWrite() = morphEditSet;
+    morphSnapshots.publish();
+}
 
-    // Process first block
-    for (int i = 0; i < size1; ++i) {
-        const auto& change = fifoBuffer[static_cast<size_t>(start1 + i)];
-        DBG("[ParameterManager] update: id=" + idToString(change.id) + ", value=" + juce::String(change.value));
-        auto it = callbacks.find(change.id);
-        if (it != callbacks.end()) {
-            it->second(change.value, false); // Real-time changes use smoothing
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::applyMorph(bool smooth) {
+    bool snapshotsChanged = false;
+    if (const auto* snapshots = morphSnapshots.acquire()) {
+        morphActiveSet = snapshots;
+        snapshotsChanged = true;
+    }
+
+    const bool active = morphEnabled.load(std::memory_order_relaxed) && morphActiveSet != nullptr &&
+                        morphActiveSet->numSnapshots >= 2;
+    if (!active) {
+        if (appliedMorphPosition >= 0.0f) {
+            // Morph released: hand control back to the APVTS values (the modulation pass reads them itself)
+            appliedMorphPosition = -1.0f;
+            for (size_t i = 0; i < MaxParams; ++i) {
+                if (parameterTable[i].parameter != nullptr && !parameterTable[i].modulationActive)
+                    applyChange(i, getNativeValue(static_cast<IDType>(i)), smooth);
+            }
         }
+        return;
+    }
+
+    const float position = std::max(0.0f, morphPosition.load(std::memory_order_relaxed));
+    const bool engaged = appliedMorphPosition >= 0.0f;
+    if (engaged && !snapshotsChanged && position == appliedMorphPosition)
+        return;
+    appliedMorphPosition = position;
+
+    // One dense pass over all parameters, then notify only the ones that moved
+    morph.process(*morphActiveSet, position, morphThreshold.load(std::memory_order_relaxed));
+    for (size_t i = 0; i < MaxParams; ++i) {
+        if (parameterTable[i].parameter == nullptr)
+            continue;
+
+        const float value = morph.getNativeValue(i);
+        if (engaged && value == morphedValues[i])
+            continue;
+        morphedValues[i] = value;
+        if (!parameterTable[i].modulationActive) // The modulation pass uses the morphed value as its base
+            applyChange(i, value, smooth);
     }
+}
 
-    // Process second block (if wrapped)
-    for (int i = 0; i < size2; ++i) {
-        const auto& change = fifoBuffer[static_cast<size_t>(start2 + i)];
-        DBG("[ParameterManager] update: id=" + idToString(change.id) + ", value=" + juce::String(change.value));
-        auto it = callbacks.find(change.id);
-        if (it != callbacks.end()) {
-            it->second(change.value, false); // Real-time changes use smoothing
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::drainMailbox(bool smooth) {
+    mailbox.drain([this, smooth](size_t index, float value) {
+        automationRecorder.record(index, value, automation_format::untimestamped);
+        if (parameterTable[index].modulationActive)
+            return; // The modulation pass reads the new host value
+        if (appliedMorphPosition >= 0.0f)
+            return; // The morph drives the DSP; releasing it applies the latest host values
+        applyChange(index, value, smooth);
+    });
+}
+
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::applyChange(size_t index, float value, bool smooth) {
+    auto& entry = parameterTable[index];
+    if (entry.rampSlot >= 0) {
+        if (smooth) {
+            entry.smoother.setTarget(value);
+            if (entry.smoother.isSmoothing())
+                return; // Delivered per sub-block by advanceSmoothers()
         }
+        entry.smoother.snapTo(value);
+    }
+
+    deliver(index, value, false); // Real-time changes use smoothing
+}
+
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::deliver(size_t index, float value, bool skipSmoothing) {
+    frame.values[index] = value;
+    pendingChanged.set(index);
+    pendingJumped.set(index, skipSmoothing);
+    if (derived != nullptr)
+        derived->invalidate(index, skipSmoothing);
+
+    auto& entry = parameterTable[index];
+    if (entry.callback) {
+        telemetry.countCallback();
+        entry.callback(value, skipSmoothing);
     }
+}
 
-    fifo.finishedRead(size1 + size2);
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::publishFrame() {
+    frame.changed = pendingChanged;
+    frame.jumped = pendingJumped;
+    pendingChanged.reset();
+    pendingJumped.reset();
 }
 
-template <typename IDType>
-void ParameterManager<IDType>::syncAll(bool skipSmoothing) {
-    for (const auto& [id, callback] : callbacks) {
-        callback(getNativeValue(id), skipSmoothing);
+template <typename IDType, size_t MaxParams>
+bool ParameterManager<IDType, MaxParams>::isAnySmoothing() const {
+    for (size_t i = 0; i < numSmoothed; ++i) {
+        if (parameterTable[smoothedIndices[i]].smoother.isSmoothing())
+            return true;
     }
+    return false;
 }
 
-template <typename IDType>
-float ParameterManager<IDType>::getValue(IDType id) const {
-    auto it = parameterMap.find(id);
-    if (it != parameterMap.end()) {
-        return it->second->getValue();
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::advanceSmoothers(int numSamples) {
+    jassert(numSamples <= smoothingBlockSize); // Ramp slots hold smoothingBlockSize samples
+    for (size_t i = 0; i < numSmoothed; ++i) {
+        const auto index = smoothedIndices[i];
+        auto& entry = parameterTable[index];
+        entry.rampActive = entry.smoother.isSmoothing();
+        if (!entry.rampActive)
+            continue;
+
+        float* ramp = rampStorage.data() + static_cast<size_t>(entry.rampSlot) * smoothingBlockSize;
+        entry.smoother.process(ramp, numSamples);
+        deliver(index, ramp[numSamples - 1], true); // Already smoothed by the framework
+    }
+}
+
+template <typename IDType, size_t MaxParams>
+const float* ParameterManager<IDType, MaxParams>::getRamp(IDType id) const {
+    jassert(toIndex(id) < MaxParams);
+    const auto& entry = parameterTable[toIndex(id)];
+    if (!entry.rampActive)
+        return nullptr;
+    return rampStorage.data() + static_cast<size_t>(entry.rampSlot) * smoothingBlockSize;
+}
+
+template <typename IDType, size_t MaxParams>
+bool ParameterManager<IDType, MaxParams>::pushEvent(IDType id, float value, int sampleOffset) {
+    jassert(toIndex(id) < MaxParams);
+    return queueEvent({toIndex(id), value, std::max(0, sampleOffset)});
+}
+
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::processMidi(const juce::MidiBuffer& midiMessages) {
+    midiLearn.beginBlock();
+    for (const auto metadata : midiMessages) {
+        const auto message = metadata.getMessage();
+        if (!message.isController())
+            continue;
+
+        const int slot = midiLearn.handleController(message.getChannel(), message.getControllerNumber());
+        if (slot < 0)
+            continue;
+
+        if (auto* param = parameterTable[static_cast<size_t>(slot)].parameter) {
+            const float normalized = static_cast<float>(message.getControllerValue()) / 127.0f;
+            queueEvent({static_cast<size_t>(slot), param->convertFrom0to1(normalized), metadata.samplePosition});
+        }
+    }
+}
+
+template <typename IDType, size_t MaxParams>
+template <typename ProcessFn>
+void ParameterManager<IDType, MaxParams>::processSubBlocks(int numSamples, ProcessFn&& process) {
+    runSubBlocks(numSamples, [](int, int) {}, std::forward<ProcessFn>(process));
+}
+
+template <typename IDType, size_t MaxParams>
+template <typename SampleType, typename ProcessFn>
+void ParameterManager<IDType, MaxParams>::processSubBlocks(const juce::AudioBuffer<SampleType>& buffer,
+                                                           int numInputChannels,
+                                                           ProcessFn&& process) {
+    const int numChannels = std::min(numInputChannels, buffer.getNumChannels());
+    runSubBlocks(
+        buffer.getNumSamples(),
+        [&](int start, int length) {
+            modulation->processInput(buffer.getArrayOfReadPointers(), numChannels, start, length);
+        },
+        std::forward<ProcessFn>(process));
+}
+
+template <typename IDType, size_t MaxParams>
+template <typename InputFn, typename ProcessFn>
+void ParameterManager<IDType, MaxParams>::runSubBlocks(int numSamples, InputFn&& feedInput, ProcessFn&& process) {
+    // Loaded states and untimestamped changes (GUI, host automation) apply at the start of the block
+    telemetry.beginBlock();
+    automationRecorder.beginBlock(numSamples);
+    applyPendingState();
+    drainMailbox(true);
+    applyMorph(true);
+
+    for (size_t i = 0; i < events.size(); ++i)
+        automationRecorder.record(events[i].index, events[i].value, events[i].sampleOffset);
+
+    size_t next = 0;
+    int start = 0;
+    while (start < numSamples) {
+        // Apply all events due at or before this split point
+        while (next < events.size() && events[next].sampleOffset <= start) {
+            applyChange(events[next].index, events[next].value, true);
+            ++next;
+        }
+
+        // Split at the next event, but never shorter than the minimum sub-block size
+        const int nextEvent = next < events.size() ? events[next].sampleOffset : numSamples;
+        int end = std::clamp(nextEvent, std::min(start + minSubBlockSize, numSamples), numSamples);
+
+        // Fixed internal chunks on a grid, whatever block size the host sends
+        if (maxSubBlockSize > 0)
+            end = std::min(end, (start / maxSubBlockSize + 1) * maxSubBlockSize);
+
+        // Ramping and modulated parameters are updated at control rate (a routing
+        // committed since the last tick must cap this sub-block already)
+        if (isAnySmoothing())
+            end = std::min(end, start + smoothingBlockSize);
+        if (modulation != nullptr) {
+            // Routed parameters (and routes being released) may start ramps in applyModulation(),
+            // so the final length is fixed before the input is fed and the sources advance
+            modulation->acquireRouting();
+            if (modulation->hasRoutes() || anyModulationActive)
+                end = std::min(end, start + modulationBlockSize);
+            feedInput(start, end - start);
+            modulation->tick(end - start);
+            applyModulation();
+        }
+
+        advanceSmoothers(end - start);
+        if (derived != nullptr)
+            derived->evaluate(); // Cheap when nothing changed since the previous sub-block
+        publishFrame();
+        telemetry.pause(); // DSP time is not parameter overhead
+        process(start, end - start);
+        telemetry.resume();
+        start = end;
+    }
+
+    // Events beyond the end of this block still take effect
+    while (next < events.size()) {
+        applyChange(events[next].index, events[next].value, true);
+        ++next;
+    }
+    telemetry.endBlock(events.size());
+    events.clear();
+}
+
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::syncAll(bool skipSmoothing) {
+    for (size_t i = 0; i < MaxParams; ++i) {
+        auto& entry = parameterTable[i];
+        if (entry.parameter == nullptr)
+            continue;
+
+        const float value = getNativeValue(static_cast<IDType>(i));
+        if (entry.rampSlot >= 0) {
+            entry.smoother.snapTo(value);
+        }
+        deliver(i, value, skipSmoothing);
+    }
+}
+
+template <typename IDType, size_t MaxParams>
+float ParameterManager<IDType, MaxParams>::getValue(IDType id) const {
+    jassert(toIndex(id) < MaxParams);
+    if (parameterTable[toIndex(id)].parameter != nullptr) {
+        return currentValue(toIndex(id));
     }
     return 0.0f;
 }
 
-template <typename IDType>
-float ParameterManager<IDType>::getNativeValue(IDType id) const {
-    auto it = parameterMap.find(id);
-    if (it != parameterMap.end()) {
-        return it->second->convertFrom0to1(it->second->getValue());
+template <typename IDType, size_t MaxParams>
+float ParameterManager<IDType, MaxParams>::getNativeValue(IDType id) const {
+    jassert(toIndex(id) < MaxParams);
+    if (auto* param = parameterTable[toIndex(id)].parameter) {
+        return param->convertFrom0to1(currentValue(toIndex(id)));
     }
     return 0.0f;
 }
 
-template <typename IDType>
-void ParameterManager<IDType>::setValue(IDType id, float value) {
-    auto it = parameterMap.find(id);
-    if (it != parameterMap.end()) {
-        it->second->setValueNotifyingHost(value);
+template <typename IDType, size_t MaxParams>
+float ParameterManager<IDType, MaxParams>::currentValue(size_t index) const {
+    const float throttled = throttledValues[index].load(std::memory_order_acquire);
+    return throttled >= 0.0f ? throttled : parameterTable[index].parameter->getValue();
+}
 
-        // Push to FIFO for audio thread
-        int start1, size1, start2, size2;
-        fifo.prepareToWrite(1, start1, size1, start2, size2);
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::setValue(IDType id, float value) {
+    jassert(toIndex(id) < MaxParams);
+    if (auto* param = parameterTable[toIndex(id)].parameter) {
+        if (hostThrottle.isEnabled()) {
+            // The DSP gets every value now; the throttle's gesture feeds the undo history
+            throttledValues[toIndex(id)].store(value, std::memory_order_release);
+            postToMailbox(toIndex(id), param->convertFrom0to1(value));
+            hostThrottle.set(toIndex(id), value);
+            return;
+        }
 
-        if (size1 > 0) {
-            fifoBuffer[static_cast<size_t>(start1)] = {id, getNativeValue(id)};
-            fifo.finishedWrite(1);
+        undoHistory.record(toIndex(id), param->getValue(), value);
+
+        // The APVTS listener posts the change to the mailbox for the audio thread
+        param->setValueNotifyingHost(value);
+    }
+}
+
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::parameterGestureChanged(int parameterIndex, bool gestureIsStarting) {
+    if (replayingHistory)
+        return;
+
+    for (size_t i = 0; i < MaxParams; ++i) {
+        auto* param = parameterTable[i].parameter;
+        if (param == nullptr || param->getParameterIndex() != parameterIndex)
+            continue;
+
+        // One undo step per gesture; overlapping gestures share a step
+        if (gestureIsStarting) {
+            gestureStartValues[i] = param->getValue();
+            undoHistory.beginTransaction();
+        } else {
+            undoHistory.record(i, gestureStartValues[i], param->getValue());
+            undoHistory.endTransaction();
         }
+        return;
     }
 }
 
-template <typename IDType>
-void ParameterManager<IDType>::saveState(juce::MemoryBlock& destData) const {
-    auto state = apvts->copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    juce::AudioProcessor::copyXmlToBinary(*xml, destData);
+template <typename IDType, size_t MaxParams>
+bool ParameterManager<IDType, MaxParams>::undo() {
+    return undoHistory.undo([this](size_t index, float value) { replayHistoryValue(index, value); });
 }
 
-template <typename IDType>
-void ParameterManager<IDType>::loadState(const void* data, int sizeInBytes) {
-    std::unique_ptr<juce::XmlElement> xml(juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes));
-    if (xml && xml->hasTagName(apvts->state.getType())) {
-        apvts->replaceState(juce::ValueTree::fromXml(*xml));
+template <typename IDType, size_t MaxParams>
+bool ParameterManager<IDType, MaxParams>::redo() {
+    return undoHistory.redo([this](size_t index, float value) { replayHistoryValue(index, value); });
+}
+
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::replayHistoryValue(size_t index, float value) {
+    auto* param = parameterTable[index].parameter;
+    if (param == nullptr)
+        return;
 
-        // Trigger callbacks for all loaded values (skip smoothing for instant preset load)
-        for (const auto& [id, callback] : callbacks) {
-            callback(getNativeValue(id), true); // Skip smoothing when loading state
+    replayingHistory = true;
+    param->beginChangeGesture();
+    param->setValueNotifyingHost(value);
+    param->endChangeGesture();
+    replayingHistory = false;
+}
+
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::setStateSchema(int version, std::vector<StateMigration> migrationSteps) {
+    jassert(version >= 1);
+    schemaVersion = version;
+    migrations = std::move(migrationSteps);
+}
+
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::saveState(juce::MemoryBlock& destData) const {
+    int numEntries = 0;
+    for (const auto& entry : parameterTable) {
+        if (entry.parameter != nullptr)
+            ++numEntries;
+    }
+
+    destData.reset();
+    destData.ensureSize(static_cast<size_t>(state_format::headerSize + numEntries * state_format::entrySize));
+    juce::MemoryOutputStream stream(destData, false);
+
+    stream.writeInt(state_format::magic);
+    stream.writeInt(state_format::formatVersion);
+    stream.writeInt(schemaVersion);
+    stream.writeInt(numEntries);
+
+    for (size_t i = 0; i < MaxParams; ++i) {
+        if (auto* param = parameterTable[i].parameter) {
+            stream.writeInt(static_cast<int>(i));
+            stream.writeFloat(param->convertFrom0to1(currentValue(i)));
         }
     }
 }
 
-template <typename IDType>
-void ParameterManager<IDType>::createAPVTS(const ParameterSet<IDType>& params, juce::AudioProcessor& processor) {
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::loadState(const void* data, int sizeInBytes) {
+    if (data == nullptr || sizeInBytes < 4)
+        return;
+
+    // Start from defaults so parameters added since the state was saved are reset
+    LoadedValues loaded{};
+    for (size_t i = 0; i < MaxParams; ++i) {
+        if (auto* param = parameterTable[i].parameter)
+            loaded[i] = param->getDefaultValue();
+    }
+
+    const bool isBinary = juce::ByteOrder::littleEndianInt(data) == static_cast<juce::uint32>(state_format::magic);
+    const bool isValid = isBinary ? readBinaryState(data, sizeInBytes, loaded)
+                                  : readXmlState(data, sizeInBytes, loaded);
+    if (!isValid)
+        return;
+
+    // GUI values the throttle has not sent yet must not overwrite the loaded ones
+    hostThrottle.discardAll();
+
+    // Hand the native values to the audio thread before notifying the host, so
+    // the mailbox never delivers part of a preset ahead of the snapshot
+    auto& snapshot = stateSnapshots.beginWrite();
+    for (size_t i = 0; i < MaxParams; ++i) {
+        if (auto* param = parameterTable[i].parameter) {
+            snapshot[i] = param->convertFrom0to1(loaded[i]);
+            throttledValues[i].store(-1.0f, std::memory_order_release); // Superseded by the state
+        }
+    }
+    stateSnapshots.publish();
+
+    // The snapshot already carries these values; their listener echoes must not reach the mailbox
+    loadingState.store(true, std::memory_order_release);
+    for (size_t i = 0; i < MaxParams; ++i) {
+        if (auto* param = parameterTable[i].parameter)
+            param->setValueNotifyingHost(loaded[i]);
+    }
+    loadingState.store(false, std::memory_order_release);
+}
+
+template <typename IDType, size_t MaxParams>
+bool ParameterManager<IDType, MaxParams>::readBinaryState(const void* data,
+                                                          int sizeInBytes,
+                                                          LoadedValues& loaded) const {
+    if (sizeInBytes < state_format::headerSize)
+        return false;
+
+    juce::MemoryInputStream stream(data, static_cast<size_t>(sizeInBytes), false);
+    stream.readInt(); // Magic (already checked)
+    const int format = stream.readInt();
+    const int savedSchema = stream.readInt();
+    const int numEntries = stream.readInt();
+
+    // Reject states written by a newer framework or truncated chunks
+    if (format > state_format::formatVersion || savedSchema > schemaVersion || numEntries < 0 ||
+        numEntries > (sizeInBytes - state_format::headerSize) / state_format::entrySize) {
+        jassertfalse;
+        return false;
+    }
 
-    for (const auto& paramVariant : params.getAll()) {
-        auto juceParam = createJuceParameter(paramVariant);
+    for (int i = 0; i < numEntries; ++i) {
+        const int id = stream.readInt();
+        const float value = stream.readFloat();
+        storeLoadedValue(id, value, savedSchema, loaded);
+    }
+    return true;
+}
 
-        // Store parameter pointer for quick access
-        std::visit(
-            [this](auto&& param) {
-                parameterMap[param.id] = nullptr; // Will be set after APVTS creation
-            },
-            paramVariant);
+template <typename IDType, size_t MaxParams>
+bool ParameterManager<IDType, MaxParams>::readXmlState(const void* data, int sizeInBytes, LoadedValues& loaded) const {
+    std::unique_ptr<juce::XmlElement> xml(juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes));
+    if (!xml || !xml->hasTagName(apvts->state.getType()))
+        return false;
 
-        layout.add(std::move(juceParam));
+    // APVTS stores one child per parameter with its string ID and native value
+    const auto state = juce::ValueTree::fromXml(*xml);
+    for (const auto& child : state) {
+        const int id = stringToIndex(child.getProperty("id").toString());
+        if (id >= 0 && child.hasProperty("value"))
+            storeLoadedValue(id, static_cast<float>(child.getProperty("value")), 1, loaded);
+    }
+    return true;
+}
+
+template <typename IDType, size_t MaxParams>
+void ParameterManager<IDType, MaxParams>::storeLoadedValue(int id,
+                                                           float nativeValue,
+                                                           int savedSchema,
+                                                           LoadedValues& loaded) const {
+    id = migrateStateId(id, savedSchema, migrations);
+    if (id < 0 || static_cast<size_t>(id) >= MaxParams)
+        return;
+
+    if (auto* param = parameterTable[static_cast<size_t>(id)].parameter)
+        loaded[static_cast<size_t>(id)] = param->convertTo0to1(nativeValue);
+}
+
+template <typename IDType, size_t MaxParams>
+template <size_t Capacity>
+void ParameterManager<IDType, MaxParams>::createAPVTS(const ParameterSet<IDType, Capacity>& params,
+                                                      juce::AudioProcessor& processor) {
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+
+    for (const auto& spec : params) {
+        layout.add(createJuceParameter(spec));
     }
 
     apvts = std::make_unique<juce::AudioProcessorValueTreeState>(processor, nullptr, "Parameters", std::move(layout));
 
-    // Now populate parameter map with actual pointers
-    for (const auto& paramVariant : params.getAll()) {
-        std::visit(
-            [this](auto&& param) {
-                auto* p = apvts->getParameter(idToString(param.id));
-                if (p) {
-                    parameterMap[param.id] = p;
-                }
-            },
-            paramVariant);
+    // Populate the dense table with parameter pointers and precomputed string IDs
+    for (const auto& spec : params) {
+        const auto index = toIndex(spec.id);
+        jassert(index < MaxParams); // Enum value exceeds table capacity
+        if (index >= MaxParams)
+            continue;
+
+        auto& entry = parameterTable[index];
+        entry.paramID = idToString(spec.id);
+        entry.parameter = apvts->getParameter(entry.paramID);
+        frame.values[index] = spec.defaultValue;
+
+        // Describe the native range for the morph engine
+        const bool isDiscrete = spec.kind != ParamKind::Float;
+        morph.setRange(index, spec.min, spec.max, spec.skew, isDiscrete);
+
+        // Reserve a ramp slot for FloatParams that declare framework smoothing
+        if (spec.kind == ParamKind::Float && spec.smoothingMs > 0.0f) {
+            entry.smoothingMs = spec.smoothingMs;
+            entry.smoothingCurve = spec.smoothingCurve;
+            entry.rampSlot = static_cast<int>(numSmoothed);
+            entry.smoother.snapTo(spec.defaultValue);
+            smoothedIndices[numSmoothed++] = index;
+        }
     }
+
+    rampStorage.fill(0.0f);
 }
 
-template <typename IDType>
+template <typename IDType, size_t MaxParams>
 std::unique_ptr<juce::RangedAudioParameter>
-ParameterManager<IDType>::createJuceParameter(const typename ParameterSet<IDType>::ParamVariant& paramVariant) {
-
-    return std::visit(
-        [this](auto&& param) -> std::unique_ptr<juce::RangedAudioParameter> {
-            using T = std::decay_t<decltype(param)>;
-            // Use juce::String everywhere for parameter IDs
-            const juce::String juceIdStr = idToString(param.id);
-
-            if constexpr (std::is_same_v<T, FloatParam<IDType>>) {
-                return std::make_unique<juce::AudioParameterFloat>(
-                    juce::ParameterID{juceIdStr, 1},
-                    param.name,
-                    juce::NormalisableRange<float>(param.min, param.max, 0.01f, param.skew),
-                    param.defaultValue,
-                    param.unit);
-            } else if constexpr (std::is_same_v<T, IntParam<IDType>>) {
-                return std::make_unique<juce::AudioParameterInt>(juce::ParameterID{juceIdStr, 1},
-                                                                 param.name,
-                                                                 param.min,
-                                                                 param.max,
-                                                                 param.defaultValue,
-                                                                 param.unit);
-            } else if constexpr (std::is_same_v<T, BoolParam<IDType>>) {
-                return std::make_unique<juce::AudioParameterBool>(juce::ParameterID{juceIdStr, 1},
-                                                                  param.name,
-                                                                  param.defaultValue);
-            } else if constexpr (std::is_same_v<T, ChoiceParam<IDType>>) {
-                juce::StringArray choices;
-                for (const auto& choice : param.choices) {
-                    choices.add(choice);
-                }
-                return std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{juceIdStr, 1},
-                                                                    param.name,
-                                                                    choices,
-                                                                    param.defaultIndex);
-            }
-        },
-        paramVariant);
+ParameterManager<IDType, MaxParams>::createJuceParameter(const ParamSpec<IDType>& spec) {
+    // Use juce::String everywhere for parameter IDs
+    const juce::ParameterID paramID{idToString(spec.id), 1};
+    const juce::String name = displayName(spec.prefix, spec.instanceNumber, spec.name);
+
+    switch (spec.kind) {
+    case ParamKind::Int:
+        return std::make_unique<juce::AudioParameterInt>(paramID,
+                                                         name,
+                                                         static_cast<int>(spec.min),
+                                                         static_cast<int>(spec.max),
+                                                         static_cast<int>(spec.defaultValue),
+                                                         toJuceString(spec.unit));
+    case ParamKind::Bool:
+        return std::make_unique<juce::AudioParameterBool>(paramID, name, spec.defaultValue >= 0.5f);
+    case ParamKind::Choice: {
+        juce::StringArray choices;
+        for (const auto& choice : spec.choices) {
+            choices.add(toJuceString(choice));
+        }
+        return std::make_unique<juce::AudioParameterChoice>(
+            paramID, name, choices, static_cast<int>(spec.defaultValue));
+    }
+    case ParamKind::Float:
+    default:
+        return std::make_unique<juce::AudioParameterFloat>(
+            paramID,
+            name,
+            juce::NormalisableRange<float>(spec.min, spec.max, 0.01f, spec.skew),
+            spec.defaultValue,
+            toJuceString(spec.unit));
+    }
 }
 
 } // namespace jnsc::juce_interface
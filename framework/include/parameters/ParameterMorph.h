@@ -0,0 +1,109 @@
+// Jonssonic Plugin Framework
+// Parameter morph - dense interpolation between full-parameter snapshots
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Dense snapshot interpolation over all parameters at once
+ *
+ * Snapshots hold normalized [0, 1] values. A morph position in
+ * [0, numSnapshots - 1] selects two neighbouring snapshots and interpolates
+ * every parameter between them in one pass over flat arrays (no per-parameter
+ * branching or virtual calls). Continuous parameters are interpolated in the
+ * normalized domain and mapped to their native range with the parameter's
+ * skew, so the morph follows the same curve as the parameter's slider.
+ * Discrete parameters switch from one snapshot to the other at a threshold.
+ *
+ * @tparam NumSlots Number of parameter slots
+ * @tparam MaxSnapshots Maximum number of snapshots
+ */
+template <size_t NumSlots, size_t MaxSnapshots = 4>
+class ParameterMorph {
+  public:
+    /// Set of captured snapshots (normalized values)
+    struct Snapshots {
+        std::array<std::array<float, NumSlots>, MaxSnapshots> values{};
+        size_t numSnapshots = 0;
+    };
+
+    /// Default constructor
+    ParameterMorph() {
+        rangeStart.fill(0.0f);
+        rangeSpan.fill(0.0f);
+        inverseSkew.fill(1.0f);
+        discrete.fill(0.0f);
+        nativeValues.fill(0.0f);
+    }
+
+    /**
+     * @brief Describe the native range of a slot
+     * @param index Slot index
+     * @param start Native range start
+     * @param end Native range end
+     * @param skew Range skew (as in juce::NormalisableRange)
+     * @param isDiscrete True for int, bool and choice parameters
+     */
+    void setRange(size_t index, float start, float end, float skew, bool isDiscrete) {
+        rangeStart[index] = start;
+        rangeSpan[index] = end - start;
+        inverseSkew[index] = skew > 0.0f ? 1.0f / skew : 1.0f;
+        discrete[index] = isDiscrete ? 1.0f : 0.0f;
+    }
+
+    /**
+     * @brief Interpolate all slots at a morph position
+     * @param snapshots Captured snapshots (at least two)
+     * @param position Morph position in [0, numSnapshots - 1]
+     * @param switchThreshold Fraction at which discrete slots switch to the next snapshot
+     */
+    void process(const Snapshots& snapshots, float position, float switchThreshold) {
+        const float maxPosition = static_cast<float>(snapshots.numSnapshots - 1);
+        position = std::clamp(position, 0.0f, maxPosition);
+
+        const size_t first = std::min(static_cast<size_t>(position), snapshots.numSnapshots - 2);
+        const float fraction = position - static_cast<float>(first);
+        const float discreteFraction = fraction >= switchThreshold ? 1.0f : 0.0f;
+
+        const float* a = snapshots.values[first].data();
+        const float* b = snapshots.values[first + 1].data();
+
+        // Normalized blend: lerp for continuous slots, step for discrete ones
+        for (size_t i = 0; i < NumSlots; ++i) {
+            const float t = fraction + discrete[i] * (discreteFraction - fraction);
+            normalizedValues[i] = a[i] + t * (b[i] - a[i]);
+        }
+
+        // Map to native range with the parameter skew
+        for (size_t i = 0; i < NumSlots; ++i) {
+            const float shaped = std::pow(std::max(normalizedValues[i], 0.0f), inverseSkew[i]);
+            nativeValues[i] = rangeStart[i] + rangeSpan[i] * shaped;
+        }
+    }
+
+    /**
+     * @brief Get the native value of a slot from the last process() call
+     * @param index Slot index
+     * @return Native value (discrete slots are rounded)
+     */
+    float getNativeValue(size_t index) const {
+        return discrete[index] != 0.0f ? std::round(nativeValues[index]) : nativeValues[index];
+    }
+
+  private:
+    std::array<float, NumSlots> rangeStart;       // Native range start per slot
+    std::array<float, NumSlots> rangeSpan;        // Native range end - start per slot
+    std::array<float, NumSlots> inverseSkew;      // 1 / skew per slot
+    std::array<float, NumSlots> discrete;         // 1 for discrete slots, 0 for continuous
+    std::array<float, NumSlots> normalizedValues; // Interpolated normalized values
+    std::array<float, NumSlots> nativeValues;     // Interpolated native values
+};
+
+} // namespace jnsc::juce_interface
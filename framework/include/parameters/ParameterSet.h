@@ -7,76 +7,63 @@
 #pragma once
 
 #include "ParameterTypes.h"
+#include <array>
 #include <stdexcept>
-#include <unordered_map>
-#include <variant>
-#include <vector>
 
 namespace jnsc::juce_interface {
 
 /**
  * @brief Container for all parameters in a plugin
  *
- * Holds parameter definitions and provides type-safe access.
+ * Holds parameter definitions in a fixed-capacity array of literal ParamSpecs,
+ * so a complete set can be built in a constant expression and placed in
+ * read-only data: no heap allocation and no lookup maps at plugin construction.
  * Supports Float, Int, Bool, and Choice parameter types.
+ *
+ * Example:
+ * @code
+ *   static constexpr ParameterSet<ID> createParams() {
+ *       ParameterSet<ID> params;
+ *       params.add(FloatParam<ID>{ID::Mix, "Mix", 0.0f, 100.0f, 50.0f, "%"});
+ *       return params;
+ *   }
+ *
+ *   static constexpr auto parameters = MyParams::createParams(); // Evaluated at compile time
+ * @endcode
+ *
+ * @tparam IDType Parameter ID enum
+ * @tparam Capacity Maximum number of parameters
  */
-template <typename IDType>
+template <typename IDType, size_t Capacity = 64>
 class ParameterSet {
   public:
-    /// Type alias for parameter variant.
-    using ParamVariant = std::variant<FloatParam<IDType>, IntParam<IDType>, BoolParam<IDType>, ChoiceParam<IDType>>;
-
     /// Default constructor.
-    ParameterSet() = default;
+    constexpr ParameterSet() = default;
 
     /**
-     * @brief Add a float parameter.
-     * @param param FloatParam to add.
+     * @brief Add a parameter.
+     * @param param FloatParam, IntParam, BoolParam or ChoiceParam to add.
+     * @throws std::length_error if the set is full (compile error in constant expressions).
      */
-    void add(FloatParam<IDType> param) {
-        params.emplace_back(param);
-        indexMap[param.id] = params.size() - 1;
-    }
-
-    /**
-     * @brief Add an integer parameter.
-     * @param param IntParam to add.
-     */
-    void add(IntParam<IDType> param) {
-        params.emplace_back(param);
-        indexMap[param.id] = params.size() - 1;
-    }
-
-    /**
-     * @brief Add a boolean parameter.
-     * @param param BoolParam to add.
-     */
-    void add(BoolParam<IDType> param) {
-        params.emplace_back(param);
-        indexMap[param.id] = params.size() - 1;
-    }
-
-    /**
-     * @brief Add a choice parameter.
-     * @param param ChoiceParam to add.
-     */
-    void add(ChoiceParam<IDType> param) {
-        params.emplace_back(param);
-        indexMap[param.id] = params.size() - 1;
+    constexpr void add(const ParamSpec<IDType>& param) {
+        if (numParams == Capacity) {
+            throw std::length_error("ParameterSet capacity exceeded");
+        }
+        params[numParams++] = param;
     }
 
     /**
      * @brief Get parameter by ID.
      * @param id Parameter ID.
-     * @return Reference to the parameter variant.
+     * @return Reference to the parameter specification.
      * @throws std::runtime_error if parameter ID not found.
      */
-    const ParamVariant& get(IDType id) const {
-        auto it = indexMap.find(id);
-        if (it == indexMap.end()) {
-            throw std::runtime_error("Parameter ID not found");
+    constexpr const ParamSpec<IDType>& get(IDType id) const {
+        for (size_t i = 0; i < numParams; ++i) {
+            if (params[i].id == id)
+                return params[i];
         }
-        return params[it->second];
+        throw std::runtime_error("Parameter ID not found");
     }
 
     /**
@@ -84,23 +71,27 @@ class ParameterSet {
      * @param id Parameter ID.
      * @return true if parameter with given ID exists, false otherwise.
      */
-    bool has(IDType id) const { return indexMap.find(id) != indexMap.end(); }
+    constexpr bool has(IDType id) const {
+        for (size_t i = 0; i < numParams; ++i) {
+            if (params[i].id == id)
+                return true;
+        }
+        return false;
+    }
 
-    /**
-     * @brief Get all parameters
-     * @return Const reference to vector of all parameter variants.
-     */
-    const std::vector<ParamVariant>& getAll() const { return params; }
+    /// Iterators over the added parameters
+    constexpr const ParamSpec<IDType>* begin() const { return params.data(); }
+    constexpr const ParamSpec<IDType>* end() const { return params.data() + numParams; }
 
     /**
      * @brief Get number of parameters
      * @return Number of parameters in the set.
      */
-    size_t size() const { return params.size(); }
+    constexpr size_t size() const { return numParams; }
 
   private:
-    std::vector<ParamVariant> params;
-    std::unordered_map<IDType, size_t> indexMap;
+    std::array<ParamSpec<IDType>, Capacity> params{};
+    size_t numParams = 0;
 };
 
 } // namespace jnsc::juce_interface
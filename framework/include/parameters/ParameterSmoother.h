@@ -0,0 +1,135 @@
+// Jonssonic Plugin Framework
+// Parameter smoother - block-based ramp generation for framework-owned smoothing
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "ParameterTypes.h"
+#include <algorithm>
+#include <cmath>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Block-based parameter smoother
+ *
+ * Instead of ticking once per sample inside every DSP setter, the smoother
+ * writes a whole ramp segment into a buffer per call. The fill loops have no
+ * loop-carried dependency, so the compiler can vectorize them.
+ *
+ * Multiplicative ramps run linearly in the log domain and fall back to a
+ * linear ramp when the start or target value is not positive.
+ *
+ * Example usage:
+ * @code
+ *   ParameterSmoother smoother;
+ *   smoother.prepare(sampleRate, 20.0f, SmoothingCurve::Multiplicative);
+ *   smoother.snapTo(1000.0f);
+ *   smoother.setTarget(2000.0f);
+ *   smoother.process(ramp, 32); // ramp[0..31] now holds the next 32 values
+ * @endcode
+ */
+class ParameterSmoother {
+  public:
+    /// Default constructor
+    ParameterSmoother() = default;
+
+    /**
+     * @brief Prepare the smoother
+     * @param sampleRate Sample rate in Hz
+     * @param timeMs Ramp length in milliseconds (0 disables smoothing)
+     * @param curve Ramp shape
+     */
+    void prepare(double sampleRate, float timeMs, SmoothingCurve curve) {
+        rampLength = std::max(0, static_cast<int>(std::round(sampleRate * timeMs * 0.001)));
+        smoothingCurve = curve;
+        snapTo(target);
+    }
+
+    /**
+     * @brief Start a ramp towards a new target
+     * @param newTarget Target value in native range
+     */
+    void setTarget(float newTarget) {
+        if (newTarget == target)
+            return;
+
+        const float current = getCurrentValue();
+        target = newTarget;
+
+        if (rampLength == 0) {
+            snapTo(newTarget);
+            return;
+        }
+
+        logDomain = smoothingCurve == SmoothingCurve::Multiplicative && current > 0.0f && newTarget > 0.0f;
+        const float start = logDomain ? std::log(current) : current;
+        const float end = logDomain ? std::log(newTarget) : newTarget;
+
+        state = start;
+        step = (end - start) / static_cast<float>(rampLength);
+        samplesRemaining = rampLength;
+    }
+
+    /**
+     * @brief Jump to a value without ramping
+     * @param value New current and target value
+     */
+    void snapTo(float value) {
+        target = value;
+        state = value;
+        step = 0.0f;
+        samplesRemaining = 0;
+        logDomain = false;
+    }
+
+    /// Check if a ramp is in progress
+    bool isSmoothing() const { return samplesRemaining > 0; }
+
+    /// Get the current (most recently produced) value
+    float getCurrentValue() const {
+        if (!isSmoothing())
+            return target;
+        return logDomain ? std::exp(state) : state;
+    }
+
+    /// Get the target value
+    float getTargetValue() const { return target; }
+
+    /**
+     * @brief Write the next numSamples values and advance the ramp
+     * @param dest Destination buffer (at least numSamples long)
+     * @param numSamples Number of samples to produce
+     */
+    void process(float* dest, int numSamples) {
+        const int numRamp = std::min(numSamples, samplesRemaining);
+        const float start = state;
+        const float inc = step;
+
+        for (int i = 0; i < numRamp; ++i)
+            dest[i] = start + inc * static_cast<float>(i + 1);
+
+        if (logDomain) {
+            for (int i = 0; i < numRamp; ++i)
+                dest[i] = std::exp(dest[i]);
+        }
+
+        std::fill(dest + numRamp, dest + numSamples, target);
+
+        samplesRemaining -= numRamp;
+        state = start + inc * static_cast<float>(numRamp);
+        if (samplesRemaining == 0)
+            snapTo(target);
+    }
+
+  private:
+    SmoothingCurve smoothingCurve = SmoothingCurve::Linear;
+    int rampLength = 0;       // Ramp length in samples
+    int samplesRemaining = 0; // Samples left in the current ramp
+    float target = 0.0f;      // Target value (native range)
+    float state = 0.0f;       // Current ramp position (log domain if multiplicative)
+    float step = 0.0f;        // Increment per sample (log domain if multiplicative)
+    bool logDomain = false;   // True while running a multiplicative ramp
+};
+
+} // namespace jnsc::juce_interface
@@ -0,0 +1,146 @@
+// Jonssonic Plugin Framework
+// Parameter telemetry - relaxed counters for the parameter path
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Counters describing parameter traffic and its audio-thread cost
+ *
+ * Written with relaxed atomics (no ordering, no locks), so reading them from
+ * the message thread for logs or a debug overlay never disturbs the audio
+ * thread. Values are statistics, not a consistent snapshot.
+ */
+class ParameterTelemetry {
+  public:
+    /// Copy of all counters at one point in time
+    struct Snapshot {
+        uint64_t eventsEnqueued;   // Changes posted to the mailbox or event queue
+        uint64_t eventsCoalesced;  // Mailbox changes replaced by a newer value before delivery
+        uint64_t eventsDropped;    // Timestamped events lost to a full event queue
+        uint32_t queueHighWater;   // Most timestamped events queued in one block
+        uint32_t callbacksLast;    // Parameter callbacks run in the last block
+        uint32_t callbacksMax;     // Most parameter callbacks run in one block
+        uint64_t updateCyclesLast; // Parameter work of the last block, in CPU cycles
+        uint64_t updateCyclesMax;  // Longest parameter work of one block, in CPU cycles
+    };
+
+    /**
+     * @brief Read the CPU cycle counter
+     *
+     * Time stamp counter on x86, virtual counter ticks on ARM64 and
+     * high-resolution timer ticks elsewhere. Only differences are meaningful.
+     */
+    static uint64_t readCycleCounter() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        return static_cast<uint64_t>(juce::Time::getHighResolutionTicks());
+#endif
+    }
+
+    /// Count a posted change (any thread)
+    void countEnqueued() noexcept { enqueued.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Count a mailbox change that replaced a pending one (any thread)
+    void countCoalesced() noexcept { coalesced.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Count a dropped timestamped event (audio thread)
+    void countDropped() noexcept { dropped.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Count a parameter callback (audio thread)
+    void countCallback() noexcept { ++blockCallbacks; }
+
+    /// Start measuring a block's parameter work (audio thread)
+    void beginBlock() noexcept {
+        blockCallbacks = 0;
+        blockCycles = 0;
+        sectionStart = readCycleCounter();
+    }
+
+    /// Pause the measurement, e.g., while the DSP processes a sub-block (audio thread)
+    void pause() noexcept { blockCycles += readCycleCounter() - sectionStart; }
+
+    /// Resume the measurement after pause() (audio thread)
+    void resume() noexcept { sectionStart = readCycleCounter(); }
+
+    /**
+     * @brief Finish the block and publish its statistics (audio thread)
+     * @param numQueuedEvents Timestamped events queued for the block
+     */
+    void endBlock(size_t numQueuedEvents) noexcept {
+        pause();
+        storeMax(queueHighWater, static_cast<uint32_t>(numQueuedEvents));
+        callbacksLast.store(blockCallbacks, std::memory_order_relaxed);
+        storeMax(callbacksMax, blockCallbacks);
+        cyclesLast.store(blockCycles, std::memory_order_relaxed);
+        storeMax(cyclesMax, blockCycles);
+    }
+
+    /// Read all counters (any thread)
+    Snapshot getSnapshot() const noexcept {
+        Snapshot snapshot{};
+        snapshot.eventsEnqueued = enqueued.load(std::memory_order_relaxed);
+        snapshot.eventsCoalesced = coalesced.load(std::memory_order_relaxed);
+        snapshot.eventsDropped = dropped.load(std::memory_order_relaxed);
+        snapshot.queueHighWater = queueHighWater.load(std::memory_order_relaxed);
+        snapshot.callbacksLast = callbacksLast.load(std::memory_order_relaxed);
+        snapshot.callbacksMax = callbacksMax.load(std::memory_order_relaxed);
+        snapshot.updateCyclesLast = cyclesLast.load(std::memory_order_relaxed);
+        snapshot.updateCyclesMax = cyclesMax.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    /// Reset all counters (any thread; a block in progress may still publish its values)
+    void reset() noexcept {
+        enqueued.store(0, std::memory_order_relaxed);
+        coalesced.store(0, std::memory_order_relaxed);
+        dropped.store(0, std::memory_order_relaxed);
+        queueHighWater.store(0, std::memory_order_relaxed);
+        callbacksLast.store(0, std::memory_order_relaxed);
+        callbacksMax.store(0, std::memory_order_relaxed);
+        cyclesLast.store(0, std::memory_order_relaxed);
+        cyclesMax.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    // Only the audio thread raises maxima, so a plain load/store is enough
+    template <typename T>
+    static void storeMax(std::atomic<T>& target, T value) noexcept {
+        if (value > target.load(std::memory_order_relaxed))
+            target.store(value, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> enqueued{0};       // Changes posted
+    std::atomic<uint64_t> coalesced{0};      // Mailbox changes replaced before delivery
+    std::atomic<uint64_t> dropped{0};        // Events lost to a full queue
+    std::atomic<uint32_t> queueHighWater{0}; // Most events queued in one block
+    std::atomic<uint32_t> callbacksLast{0};  // Callbacks in the last block
+    std::atomic<uint32_t> callbacksMax{0};   // Most callbacks in one block
+    std::atomic<uint64_t> cyclesLast{0};     // Parameter work of the last block
+    std::atomic<uint64_t> cyclesMax{0};      // Longest parameter work of one block
+    uint32_t blockCallbacks = 0;             // Callbacks in the current block (audio thread)
+    uint64_t blockCycles = 0;                // Cycles measured in the current block (audio thread)
+    uint64_t sectionStart = 0;               // Start of the running measurement (audio thread)
+};
+
+} // namespace jnsc::juce_interface
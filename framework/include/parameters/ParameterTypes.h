@@ -6,29 +6,78 @@
 
 #pragma once
 
-#include <string>
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <string_view>
 
 namespace jnsc::juce_interface {
 
+/**
+ * @brief Ramp shape used by framework-owned parameter smoothing
+ * - Linear: constant step per sample (gains in dB, percentages)
+ * - Multiplicative: constant ratio per sample (frequencies, times; values must be > 0)
+ */
+enum class SmoothingCurve { Linear, Multiplicative };
+
+/**
+ * @brief Fixed-capacity list of choice labels (usable in constant expressions)
+ * Labels are string views, so they must refer to static strings (e.g., literals).
+ */
+struct ChoiceList {
+    static constexpr size_t maxChoices = 16;
+
+    std::array<std::string_view, maxChoices> items{};
+    size_t count = 0;
+
+    constexpr ChoiceList() = default;
+
+    /// @throws std::length_error if there are more than maxChoices labels (compile error in constant expressions)
+    constexpr ChoiceList(std::initializer_list<std::string_view> labels) {
+        if (labels.size() > maxChoices) {
+            throw std::length_error("ChoiceList capacity exceeded");
+        }
+        for (auto label : labels)
+            items[count++] = label;
+    }
+
+    constexpr size_t size() const { return count; }
+    constexpr const std::string_view* begin() const { return items.data(); }
+    constexpr const std::string_view* end() const { return items.data() + count; }
+};
+
 /**
  * @brief Floating-point parameter specification
  * Defines a continuous parameter with range, default, unit, and skew factor.
  * The skew factor controls the slider's response curve (1.0 = linear).
+ * A non-zero smoothing time makes the ParameterManager ramp the value itself
+ * (see ParameterManager::processSubBlocks), 0 leaves smoothing to the DSP.
  * @tparam IDType Type used for parameter IDs
  */
 template <typename IDType>
 struct FloatParam {
     IDType id;
-    std::string name;
+    std::string_view name;
     float min;
     float max;
     float defaultValue;
-    std::string unit = "";
+    std::string_view unit = "";
     float skew = 1.0f;
+    float smoothingMs = 0.0f;
+    SmoothingCurve smoothingCurve = SmoothingCurve::Linear;
 
-    FloatParam(IDType id, std::string name, float min, float max, float def, std::string unit = "", float skew = 1.0f)
-        : id(id), name(std::move(name)), min(min), max(max), defaultValue(def), unit(std::move(unit)), skew(skew) {}
+    constexpr FloatParam(IDType id,
+                         std::string_view name,
+                         float min,
+                         float max,
+                         float def,
+                         std::string_view unit = "",
+                         float skew = 1.0f,
+                         float smoothingMs = 0.0f,
+                         SmoothingCurve smoothingCurve = SmoothingCurve::Linear)
+        : id(id), name(name), min(min), max(max), defaultValue(def), unit(unit), skew(skew), smoothingMs(smoothingMs),
+          smoothingCurve(smoothingCurve) {}
 };
 
 /**
@@ -39,14 +88,14 @@ struct FloatParam {
 template <typename IDType>
 struct IntParam {
     IDType id;
-    std::string name;
+    std::string_view name;
     int min;
     int max;
     int defaultValue;
-    std::string unit = "";
+    std::string_view unit = "";
 
-    IntParam(IDType id, std::string name, int min, int max, int def, std::string unit = "")
-        : id(id), name(std::move(name)), min(min), max(max), defaultValue(def), unit(std::move(unit)) {}
+    constexpr IntParam(IDType id, std::string_view name, int min, int max, int def, std::string_view unit = "")
+        : id(id), name(name), min(min), max(max), defaultValue(def), unit(unit) {}
 };
 
 /**
@@ -57,14 +106,17 @@ struct IntParam {
 template <typename IDType>
 struct BoolParam {
     IDType id;
-    std::string name;
+    std::string_view name;
     bool defaultValue;
-    std::string trueLabel;
-    std::string falseLabel;
+    std::string_view trueLabel;
+    std::string_view falseLabel;
 
-    BoolParam(IDType id, std::string name, bool def, std::string trueLabel = "On", std::string falseLabel = "Off")
-        : id(id), name(std::move(name)), defaultValue(def), trueLabel(std::move(trueLabel)),
-          falseLabel(std::move(falseLabel)) {}
+    constexpr BoolParam(IDType id,
+                        std::string_view name,
+                        bool def,
+                        std::string_view trueLabel = "On",
+                        std::string_view falseLabel = "Off")
+        : id(id), name(name), defaultValue(def), trueLabel(trueLabel), falseLabel(falseLabel) {}
 };
 
 /**
@@ -75,12 +127,64 @@ struct BoolParam {
 template <typename IDType>
 struct ChoiceParam {
     IDType id;
-    std::string name;
-    std::vector<std::string> choices;
+    std::string_view name;
+    ChoiceList choices;
     int defaultIndex;
 
-    ChoiceParam(IDType id, std::string name, std::vector<std::string> choices, int def)
-        : id(id), name(std::move(name)), choices(std::move(choices)), defaultIndex(def) {}
+    constexpr ChoiceParam(IDType id, std::string_view name, ChoiceList choices, int def)
+        : id(id), name(name), choices(choices), defaultIndex(def) {}
+};
+
+/**
+ * @brief Kind of parameter held by a ParamSpec
+ */
+enum class ParamKind { Float, Int, Bool, Choice };
+
+/**
+ * @brief Unified, literal parameter description stored by ParameterSet
+ *
+ * Built implicitly from FloatParam, IntParam, BoolParam and ChoiceParam, so a
+ * whole parameter set can be a constant expression. Integer, boolean and
+ * choice values are stored as floats (choice range is [0, numChoices - 1]).
+ *
+ * @tparam IDType Type used for parameter IDs
+ */
+template <typename IDType>
+struct ParamSpec {
+    ParamKind kind = ParamKind::Float;
+    IDType id{};
+    std::string_view name;
+    std::string_view prefix; // Group instance prefix (see ParameterGroup)
+    int instanceNumber = 0;  // Appended to the prefix if > 0 (see ParameterGroup)
+    float min = 0.0f;
+    float max = 1.0f;
+    float defaultValue = 0.0f;
+    std::string_view unit;
+    float skew = 1.0f;
+    float smoothingMs = 0.0f;
+    SmoothingCurve smoothingCurve = SmoothingCurve::Linear;
+    std::string_view trueLabel;
+    std::string_view falseLabel;
+    ChoiceList choices;
+
+    constexpr ParamSpec() = default;
+
+    constexpr ParamSpec(const FloatParam<IDType>& p)
+        : kind(ParamKind::Float), id(p.id), name(p.name), min(p.min), max(p.max), defaultValue(p.defaultValue),
+          unit(p.unit), skew(p.skew), smoothingMs(p.smoothingMs), smoothingCurve(p.smoothingCurve) {}
+
+    constexpr ParamSpec(const IntParam<IDType>& p)
+        : kind(ParamKind::Int), id(p.id), name(p.name), min(static_cast<float>(p.min)), max(static_cast<float>(p.max)),
+          defaultValue(static_cast<float>(p.defaultValue)), unit(p.unit) {}
+
+    constexpr ParamSpec(const BoolParam<IDType>& p)
+        : kind(ParamKind::Bool), id(p.id), name(p.name), defaultValue(p.defaultValue ? 1.0f : 0.0f),
+          trueLabel(p.trueLabel), falseLabel(p.falseLabel) {}
+
+    constexpr ParamSpec(const ChoiceParam<IDType>& p)
+        : kind(ParamKind::Choice), id(p.id), name(p.name),
+          max(p.choices.size() > 0 ? static_cast<float>(p.choices.size() - 1) : 0.0f),
+          defaultValue(static_cast<float>(p.defaultIndex)), choices(p.choices) {}
 };
 
 } // namespace jnsc::juce_interface
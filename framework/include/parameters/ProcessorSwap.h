@@ -0,0 +1,297 @@
+// Jonssonic Plugin Framework
+// Processor swap - off-thread DSP rebuilds with a crossfaded lock-free handover
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "../utils/SampleType.h"
+
+#include <juce_core/juce_core.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Owns a DSP object and replaces it without allocating on the audio thread
+ *
+ * For changes that reallocate or re-prepare a DSP object (oversampling,
+ * buffer sizes, topology), QueuedParameter only moves the work to the start
+ * of a block. ProcessorSwap instead builds a fully prepared replacement with
+ * a factory on a background thread, hands it to the audio thread through an
+ * atomic pointer, crossfades from the old instance to the new one and
+ * returns the old instance to the background thread for destruction.
+ *
+ * Example usage:
+ * @code
+ *   ProcessorSwap<MyDsp> dsp;
+ *   dsp.setFactory([this] {
+ *       auto fresh = std::make_unique<MyDsp>();
+ *       fresh->prepare(numChannels, maxBlockSize, sampleRate, requestedFactor.load());
+ *       return fresh;
+ *   });
+ *   dsp.setOnPickup([this](MyDsp& d) { d.setGain(gain); }); // Changes made while it was being built
+ *   dsp.prepare(sampleRate, numChannels, maxBlockSize); // prepareToPlay
+ *
+ *   // Any thread (lock-free):
+ *   requestedFactor.store(4);
+ *   dsp.requestRebuild();
+ *
+ *   // Audio thread:
+ *   dsp.apply([&](MyDsp& d) { d.setGain(gain); }); // Settings reach both instances while fading
+ *   dsp.process(channels, numChannels, numSamples, [](MyDsp& d, float* const* ch, size_t n) {
+ *       d.processBlock(ch, ch, n);
+ *   });
+ * @endcode
+ *
+ * @tparam T DSP type
+ * @tparam SampleType Sample type of the processed blocks (by default T's, e.g., double for Distortion<double>)
+ */
+template <typename T, typename SampleType = typename SampleTypeOf<T>::type>
+class ProcessorSwap {
+  public:
+    /// Builds a fully prepared instance (called on the background thread, and in prepare())
+    using Factory = std::function<std::unique_ptr<T>()>;
+
+    /// Called on the audio thread when a new instance takes over
+    using ActivateCallback = std::function<void(T&)>;
+
+    /// Default constructor
+    ProcessorSwap() = default;
+
+    /// Destructor (stops the background thread and destroys all instances)
+    ~ProcessorSwap() { release(); }
+
+    /**
+     * @brief Set the factory (message thread, before prepare())
+     * @param newFactory Function returning a fully prepared instance
+     */
+    void setFactory(Factory newFactory) { factory = std::move(newFactory); }
+
+    /**
+     * @brief Set a callback invoked when a new instance takes over (message thread, before prepare())
+     * @param callback Function called on the audio thread with the new instance (e.g., report latency)
+     */
+    void setOnActivate(ActivateCallback callback) { onActivate = std::move(callback); }
+
+    /**
+     * @brief Set a callback bringing a built instance up to date (message thread, before prepare())
+     *
+     * apply() only reaches the active and fading instances, so settings changed
+     * between the factory run and the pickup would be missing from the new
+     * instance. The callback runs on the audio thread when the instance is
+     * picked up, before it takes over; re-apply the current settings there.
+     *
+     * @param callback Function called with the picked-up instance
+     */
+    void setOnPickup(ActivateCallback callback) { onPickup = std::move(callback); }
+
+    /**
+     * @brief Build the first instance and start the background thread (call in prepareToPlay)
+     * @param sampleRate Sample rate in Hz
+     * @param numChannels Maximum number of channels passed to process()
+     * @param maxBlockSize Crossfade chunk size in samples (longer blocks are processed in chunks)
+     * @param crossfadeMs Crossfade length in milliseconds
+     */
+    void prepare(double sampleRate, int numChannels, int maxBlockSize, float crossfadeMs = 10.0f) {
+        jassert(factory != nullptr); // Call setFactory() first
+        release();
+
+        fadeLength = std::max(1, static_cast<int>(sampleRate * crossfadeMs * 0.001));
+        fadeStorage.assign(static_cast<size_t>(numChannels),
+                           std::vector<SampleType>(static_cast<size_t>(maxBlockSize)));
+        fadePointers.resize(static_cast<size_t>(numChannels));
+        chunkPointers.resize(static_cast<size_t>(numChannels));
+        for (size_t ch = 0; ch < fadeStorage.size(); ++ch)
+            fadePointers[ch] = fadeStorage[ch].data();
+
+        active = factory();
+        builtGeneration = requestedGeneration.load(std::memory_order_acquire);
+        if (onActivate != nullptr && active != nullptr)
+            onActivate(*active);
+
+        rebuildThread = std::make_unique<RebuildThread>(*this);
+        rebuildThread->startThread();
+    }
+
+    /// Stop the background thread and destroy all instances (message thread)
+    void release() {
+        if (rebuildThread) {
+            rebuildThread->signalThreadShouldExit();
+            rebuildThread->notify();
+            rebuildThread->stopThread(1000);
+            rebuildThread.reset();
+        }
+
+        delete incoming.exchange(nullptr, std::memory_order_acq_rel);
+        collectRetired();
+        delete unretired;
+        unretired = nullptr;
+        fading.reset();
+        active.reset();
+    }
+
+    /// Ask the background thread for a new instance (any thread, lock-free)
+    void requestRebuild() { requestedGeneration.fetch_add(1, std::memory_order_release); }
+
+    /// Get the active instance (audio thread, or message thread while not playing)
+    T& get() { return *active; }
+
+    /**
+     * @brief Apply a setting to the active instance and, while fading, the outgoing one
+     * @param fn Callable invoked as fn(T&)
+     */
+    template <typename Fn>
+    void apply(Fn&& fn) {
+        if (active)
+            fn(*active);
+        if (fading)
+            fn(*fading);
+    }
+
+    /// Check if a crossfade is in progress (audio thread)
+    bool isCrossfading() const { return fading != nullptr; }
+
+    /**
+     * @brief Process a block in place, crossfading to a newly built instance if one is ready (audio thread)
+     * @param channels Channel pointers (processed in place)
+     * @param numChannels Number of channels (at most the prepared number)
+     * @param numSamples Number of samples
+     * @param fn Callable invoked as fn(T&, SampleType* const* channels, size_t numSamples)
+     */
+    template <typename ProcessFn>
+    void process(SampleType* const* channels, int numChannels, int numSamples, ProcessFn&& fn) {
+        beginBlock();
+
+        int offset = 0;
+        const int maxChunk = fadeStorage.empty() ? 0 : static_cast<int>(fadeStorage[0].size());
+        const auto numCh = static_cast<size_t>(std::min(numChannels, static_cast<int>(fadeStorage.size())));
+        while (fading && offset < numSamples && maxChunk > 0) {
+            const int length = std::min({numSamples - offset, maxChunk, fadeLength - fadePosition});
+
+            // Outgoing instance runs on a copy of the input
+            for (size_t ch = 0; ch < numCh; ++ch) {
+                std::copy_n(channels[ch] + offset, length, fadePointers[ch]);
+                chunkPointers[ch] = channels[ch] + offset;
+            }
+            fn(*fading, fadePointers.data(), static_cast<size_t>(length));
+            fn(*active, chunkPointers.data(), static_cast<size_t>(length));
+
+            // Linear crossfade from the outgoing output to the incoming output
+            const auto step = SampleType(1) / static_cast<SampleType>(fadeLength);
+            for (size_t ch = 0; ch < numCh; ++ch) {
+                SampleType gain = static_cast<SampleType>(fadePosition) * step;
+                const SampleType* from = fadePointers[ch];
+                SampleType* to = chunkPointers[ch];
+                for (int i = 0; i < length; ++i, gain += step)
+                    to[i] = from[i] + gain * (to[i] - from[i]);
+            }
+
+            offset += length;
+            fadePosition += length;
+            if (fadePosition >= fadeLength)
+                retire(fading.release());
+        }
+
+        if (offset == 0) {
+            fn(*active, channels, static_cast<size_t>(numSamples));
+        } else if (offset < numSamples) {
+            for (size_t ch = 0; ch < numCh; ++ch)
+                chunkPointers[ch] = channels[ch] + offset;
+            fn(*active, chunkPointers.data(), static_cast<size_t>(numSamples - offset));
+        }
+    }
+
+  private:
+    static constexpr int retireSlots = 4;     // Outgoing instances awaiting destruction
+    static constexpr int pollIntervalMs = 10; // Background thread polling interval
+
+    // Background thread building new instances and destroying retired ones
+    class RebuildThread : public juce::Thread {
+      public:
+        explicit RebuildThread(ProcessorSwap& swap) : juce::Thread("ProcessorSwap"), owner(swap) {}
+
+        void run() override {
+            while (!threadShouldExit()) {
+                owner.collectRetired();
+
+                const auto generation = owner.requestedGeneration.load(std::memory_order_acquire);
+                if (generation != owner.builtGeneration && owner.factory != nullptr) {
+                    owner.builtGeneration = generation;
+                    // A build the audio thread has not picked up yet is superseded
+                    delete owner.incoming.exchange(owner.factory().release(), std::memory_order_acq_rel);
+                    continue;
+                }
+                wait(pollIntervalMs);
+            }
+        }
+
+      private:
+        ProcessorSwap& owner;
+    };
+
+    // Pick up a new instance unless a crossfade is still running (audio thread)
+    void beginBlock() {
+        if (unretired != nullptr && pushRetired(unretired))
+            unretired = nullptr;
+
+        if (fading || unretired != nullptr || incoming.load(std::memory_order_relaxed) == nullptr)
+            return;
+
+        if (T* fresh = incoming.exchange(nullptr, std::memory_order_acq_rel)) {
+            if (onPickup != nullptr)
+                onPickup(*fresh); // Settings applied since the factory ran
+            fading = std::move(active);
+            active.reset(fresh);
+            fadePosition = 0;
+            if (onActivate != nullptr)
+                onActivate(*active);
+        }
+    }
+
+    // Hand an outgoing instance to the background thread (audio thread)
+    void retire(T* instance) {
+        if (!pushRetired(instance))
+            unretired = instance; // Retried at the next block
+    }
+
+    bool pushRetired(T* instance) {
+        for (auto& slot : retired) {
+            T* expected = nullptr;
+            if (slot.compare_exchange_strong(expected, instance, std::memory_order_acq_rel))
+                return true;
+        }
+        return false;
+    }
+
+    // Destroy retired instances (background thread, or message thread when stopped)
+    void collectRetired() {
+        for (auto& slot : retired)
+            delete slot.exchange(nullptr, std::memory_order_acq_rel);
+    }
+
+    Factory factory;                                    // Builds prepared instances
+    ActivateCallback onActivate;                        // Called when an instance takes over
+    ActivateCallback onPickup;                          // Brings a picked-up instance up to date
+    std::unique_ptr<T> active;                          // Instance producing the output (audio thread)
+    std::unique_ptr<T> fading;                          // Outgoing instance while crossfading (audio thread)
+    T* unretired = nullptr;                             // Outgoing instance waiting for a free retire slot
+    std::atomic<T*> incoming{nullptr};                  // Built instance awaiting pickup
+    std::array<std::atomic<T*>, retireSlots> retired{}; // Outgoing instances awaiting destruction
+    std::atomic<uint32_t> requestedGeneration{0};       // Incremented by requestRebuild()
+    uint32_t builtGeneration = 0;                       // Last generation built (background thread)
+    int fadeLength = 1;                                 // Crossfade length in samples
+    int fadePosition = 0;                               // Samples into the current crossfade
+    std::vector<std::vector<SampleType>> fadeStorage;   // Outgoing instance output, one chunk per channel
+    std::vector<SampleType*> fadePointers;              // Channel pointers into fadeStorage
+    std::vector<SampleType*> chunkPointers;             // Channel pointers into the host block at the chunk offset
+    std::unique_ptr<RebuildThread> rebuildThread;       // Builds and destroys instances
+};
+
+} // namespace jnsc::juce_interface
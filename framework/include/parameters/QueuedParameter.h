@@ -24,6 +24,11 @@ namespace jnsc::juce_interface {
  * - During silence
  * - Custom condition
  *
+ * The change itself still runs on the audio thread. For changes that allocate,
+ * use ProcessorSwap to build a replacement DSP object on a background thread.
+ * T must be small and trivially copyable (std::atomic<T>); for payloads such as
+ * impulse responses or coefficient sets, use QueuedPayload.
+ *
  * Example usage:
  * @code
  *   QueuedParameter<int> oversamplingFactor;
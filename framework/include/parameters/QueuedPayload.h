@@ -0,0 +1,118 @@
+// Jonssonic Plugin Framework
+// Queued Payload - Lock-free hand-over of large parameter payloads
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "SnapshotExchange.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Companion to QueuedParameter for large, non-trivially-copyable payloads
+ *
+ * QueuedParameter stores a std::atomic<T>, which only suits small trivially
+ * copyable values. QueuedPayload passes payloads such as impulse responses,
+ * coefficient sets or wavetables (e.g., std::vector<float>) through a triple
+ * buffer: the writer fills a private buffer and publishes it, the audio thread
+ * picks up the latest one wait-free. Payloads are never copied, allocated or
+ * freed on the audio thread; the memory of replaced payloads is released on
+ * the writer thread when it reuses or reclaims a buffer.
+ *
+ * One writer thread (GUI or worker) and one reader thread (audio) only.
+ *
+ * Example usage:
+ * @code
+ *   QueuedPayload<std::vector<float>> impulseResponse;
+ *
+ *   // Worker thread: fill in place (reuses the buffer's capacity) or move in
+ *   impulseResponse.set([&](std::vector<float>& ir) { loadImpulseResponse(file, ir); });
+ *   impulseResponse.set(std::move(newTable));
+ *
+ *   // Audio thread: switch at a safe point
+ *   if (const auto* ir = impulseResponse.getAndClear()) {
+ *       convolver.setImpulseResponse(ir->data(), ir->size());
+ *   }
+ * @endcode
+ *
+ * @tparam T Payload type (default-constructible and move-assignable)
+ */
+template <typename T>
+class QueuedPayload {
+  public:
+    /// Default constructor
+    QueuedPayload() = default;
+
+    /**
+     * @brief Queue a new payload (writer thread)
+     * @param value Payload to move in; the previous content of the buffer is freed here
+     */
+    void set(T value) {
+        exchange.beginWrite() = std::move(value);
+        exchange.publish();
+    }
+
+    /**
+     * @brief Fill a buffer in place and queue it (writer thread)
+     * @tparam FillFunc Type of fill function
+     * @param fill Function invoked as fill(T&) on a buffer holding a stale payload
+     */
+    template <typename FillFunc, std::enable_if_t<std::is_invocable_v<FillFunc&, T&>, int> = 0>
+    void set(FillFunc&& fill) {
+        fill(exchange.beginWrite());
+        exchange.publish();
+    }
+
+    /**
+     * @brief Free the memory of the writer's stale buffer (writer thread)
+     * Call after queuing a much smaller payload to give back the memory of a large one.
+     */
+    void reclaim() { exchange.beginWrite() = T{}; }
+
+    /**
+     * @brief Check if there's a pending payload
+     * @return True if a payload is queued
+     */
+    bool hasPendingChange() const { return exchange.hasPending(); }
+
+    /**
+     * @brief Take the latest payload if a new one was queued (audio thread)
+     * @return Pointer to the new payload, or nullptr if none.
+     * Stays valid until a later call picks up another payload.
+     */
+    const T* getAndClear() {
+        if (const auto* payload = exchange.acquire()) {
+            current = payload;
+            return payload;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Take the latest payload if custom condition is met (audio thread)
+     * @tparam ConditionFunc Type of condition function
+     * @param condition Function returning true when safe to apply
+     * @return Pointer to the new payload if condition met, or nullptr
+     */
+    template <typename ConditionFunc>
+    const T* getIf(ConditionFunc condition) {
+        if (!exchange.hasPending() || !condition())
+            return nullptr;
+        return getAndClear();
+    }
+
+    /**
+     * @brief Get the payload most recently taken by the audio thread
+     * @return Pointer to the payload, or nullptr if none was taken yet
+     */
+    const T* get() const { return current; }
+
+  private:
+    SnapshotExchange<T> exchange; // Triple buffer
+    const T* current = nullptr;   // Payload in use by the audio thread
+};
+
+} // namespace jnsc::juce_interface
@@ -0,0 +1,78 @@
+// Jonssonic Plugin Framework
+// Snapshot exchange - lock-free hand-over of immutable snapshots between two threads
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Single-writer, single-reader exchange of the latest snapshot
+ *
+ * Three preallocated slots are rotated with a single atomic exchange: the
+ * writer fills its private slot and publishes it, the reader swaps its slot
+ * for the most recently published one. Neither side ever blocks, allocates or
+ * frees memory, and a published snapshot is never modified while the reader
+ * holds it. Snapshots published faster than the reader polls are skipped, so
+ * the reader always sees the latest one.
+ *
+ * Example usage:
+ * @code
+ *   SnapshotExchange<Settings> exchange;
+ *
+ *   // Writer thread:
+ *   auto& next = exchange.beginWrite();
+ *   next = ...;
+ *   exchange.publish();
+ *
+ *   // Reader thread:
+ *   if (const auto* snapshot = exchange.acquire())
+ *       apply(*snapshot);
+ * @endcode
+ *
+ * @tparam T Snapshot type (copy-assignable, preferably fixed-size)
+ */
+template <typename T>
+class SnapshotExchange {
+  public:
+    /// Default constructor
+    SnapshotExchange() = default;
+
+    /**
+     * @brief Get the writer's private slot to fill (writer thread only)
+     * @return Slot that is not visible to the reader until publish()
+     */
+    T& beginWrite() noexcept { return slots[backIndex]; }
+
+    /// Publish the slot returned by beginWrite() (writer thread only)
+    void publish() noexcept { backIndex = latest.exchange(backIndex | newFlag, std::memory_order_acq_rel) & indexMask; }
+
+    /**
+     * @brief Take the most recently published snapshot (reader thread only)
+     * @return Snapshot published since the last call, or nullptr if there is none.
+     * Stays valid until the next call.
+     */
+    const T* acquire() noexcept {
+        if ((latest.load(std::memory_order_relaxed) & newFlag) == 0)
+            return nullptr;
+        frontIndex = latest.exchange(frontIndex, std::memory_order_acq_rel) & indexMask;
+        return &slots[frontIndex];
+    }
+
+    /// Check if a snapshot is waiting to be acquired
+    bool hasPending() const noexcept { return (latest.load(std::memory_order_acquire) & newFlag) != 0; }
+
+  private:
+    static constexpr int newFlag = 4;   // Set while the latest slot has not been acquired
+    static constexpr int indexMask = 3; // Slot index bits
+
+    std::array<T, 3> slots{};
+    int backIndex = 0;          // Writer's slot
+    int frontIndex = 1;         // Reader's slot
+    std::atomic<int> latest{2}; // Most recently published slot (+ newFlag)
+};
+
+} // namespace jnsc::juce_interface
@@ -0,0 +1,71 @@
+// Jonssonic Plugin Framework
+// Binary plugin state format and schema migrations
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <vector>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Binary state chunk layout
+ *
+ * Header: magic, format version, schema version, entry count (int32 each).
+ * Body: one {int32 stable ID, float native value} pair per parameter.
+ * All fields are little-endian. The stable ID is the parameter enum value.
+ * Chunks that do not start with the magic are treated as legacy XML state.
+ */
+namespace state_format {
+inline constexpr int magic = 0x424E534A; // "JNSB" read as little-endian int
+inline constexpr int formatVersion = 1;
+inline constexpr int headerSize = 16;
+inline constexpr int entrySize = 8;
+} // namespace state_format
+
+/**
+ * @brief Saved parameter value
+ * @param id Stable parameter ID (enum value)
+ * @param value Value in native range
+ */
+struct StateEntry {
+    int id;
+    float value;
+};
+
+/**
+ * @brief Schema migration step for renamed or removed parameters
+ *
+ * Applied to states saved with a schema version lower than schemaVersion.
+ * Steps are applied in order, so renames can be chained across versions.
+ * Parameters added in a newer schema need no step: they keep their default.
+ *
+ * @param schemaVersion Schema version that introduced the change
+ * @param oldId Stable ID in the older schema
+ * @param newId Stable ID in the newer schema (-1 = parameter removed)
+ */
+struct StateMigration {
+    int schemaVersion;
+    int oldId;
+    int newId;
+};
+
+/**
+ * @brief Map a saved stable ID to the current schema
+ * @param id Stable ID as saved
+ * @param savedSchema Schema version the state was saved with
+ * @param migrations Migration steps (ordered by schema version)
+ * @return Current stable ID, or -1 if the parameter was removed
+ */
+inline int migrateStateId(int id, int savedSchema, const std::vector<StateMigration>& migrations) {
+    for (const auto& step : migrations) {
+        if (savedSchema < step.schemaVersion && id == step.oldId)
+            id = step.newId;
+        if (id < 0)
+            break;
+    }
+    return id;
+}
+
+} // namespace jnsc::juce_interface
@@ -0,0 +1,153 @@
+// Jonssonic Plugin Framework
+// Undo history - gesture-coalesced parameter deltas in a fixed-size ring
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Bounded undo/redo log of parameter changes
+ *
+ * Each entry is a {parameter index, old value, new value} delta in normalized
+ * units. Deltas recorded inside a transaction form one undo step, and repeated
+ * changes of a parameter within a transaction collapse into one delta, so a
+ * whole slider drag costs a single entry. When the ring is full, the oldest
+ * steps are dropped. No allocation after construction.
+ *
+ * Message thread only (ParameterManager records gestures into it).
+ *
+ * @tparam Capacity Maximum number of deltas kept
+ */
+template <size_t Capacity = 1024>
+class UndoHistory {
+  public:
+    /// One recorded change
+    struct Delta {
+        uint32_t step;  // Undo step the delta belongs to
+        uint32_t index; // Parameter table index
+        float oldValue; // Normalized value before the change
+        float newValue; // Normalized value after the change
+    };
+
+    /// Default constructor
+    UndoHistory() = default;
+
+    /// Open a transaction: deltas until the matching endTransaction() form one undo step (nestable)
+    void beginTransaction() {
+        if (transactionDepth++ == 0)
+            ++currentStep;
+    }
+
+    /// Close a transaction
+    void endTransaction() {
+        if (transactionDepth > 0)
+            --transactionDepth;
+    }
+
+    /**
+     * @brief Record a change (outside a transaction it forms its own undo step)
+     * @param index Parameter table index
+     * @param oldValue Normalized value before the change
+     * @param newValue Normalized value after the change
+     */
+    void record(size_t index, float oldValue, float newValue) {
+        if (oldValue == newValue)
+            return;
+        if (transactionDepth == 0)
+            ++currentStep;
+
+        // Recording discards the redo branch
+        end = cursor;
+
+        // Coalesce with an earlier delta of the same parameter in this step
+        for (uint64_t i = cursor; i > begin; --i) {
+            auto& delta = deltas[(i - 1) % Capacity];
+            if (delta.step != currentStep)
+                break;
+            if (delta.index == index) {
+                delta.newValue = newValue;
+                return;
+            }
+        }
+
+        if (end - begin == Capacity)
+            dropOldestStep();
+
+        deltas[end % Capacity] = {currentStep, static_cast<uint32_t>(index), oldValue, newValue};
+        cursor = ++end;
+    }
+
+    /// Check if there is a step to undo
+    bool canUndo() const { return cursor > begin; }
+
+    /// Check if there is a step to redo
+    bool canRedo() const { return cursor < end; }
+
+    /**
+     * @brief Revert the last step
+     * @param apply Callable invoked as apply(size_t index, float normalizedValue) per delta, newest first
+     * @return False if there was nothing to undo
+     */
+    template <typename ApplyFn>
+    bool undo(ApplyFn&& apply) {
+        if (!canUndo())
+            return false;
+
+        const uint32_t step = deltas[(cursor - 1) % Capacity].step;
+        while (cursor > begin && deltas[(cursor - 1) % Capacity].step == step) {
+            const auto& delta = deltas[--cursor % Capacity];
+            apply(static_cast<size_t>(delta.index), delta.oldValue);
+        }
+        ++currentStep; // Later changes never merge into an undone step
+        return true;
+    }
+
+    /**
+     * @brief Re-apply the last undone step
+     * @param apply Callable invoked as apply(size_t index, float normalizedValue) per delta, oldest first
+     * @return False if there was nothing to redo
+     */
+    template <typename ApplyFn>
+    bool redo(ApplyFn&& apply) {
+        if (!canRedo())
+            return false;
+
+        const uint32_t step = deltas[cursor % Capacity].step;
+        while (cursor < end && deltas[cursor % Capacity].step == step) {
+            const auto& delta = deltas[cursor++ % Capacity];
+            apply(static_cast<size_t>(delta.index), delta.newValue);
+        }
+        ++currentStep;
+        return true;
+    }
+
+    /// Remove all steps
+    void clear() { begin = end = cursor = 0; }
+
+    /// Get the number of deltas held (undo and redo)
+    size_t size() const { return static_cast<size_t>(end - begin); }
+
+  private:
+    // Make room by removing the oldest step entirely (a partial step could not be undone)
+    void dropOldestStep() {
+        const uint32_t step = deltas[begin % Capacity].step;
+        while (begin < end && deltas[begin % Capacity].step == step)
+            ++begin;
+        cursor = std::max(cursor, begin);
+    }
+
+    std::array<Delta, Capacity> deltas{}; // Ring of deltas
+    uint64_t begin = 0;                   // Oldest delta (monotonic position)
+    uint64_t end = 0;                     // One past the newest delta, including redo
+    uint64_t cursor = 0;                  // One past the newest applied delta
+    uint32_t currentStep = 0;             // Step of the next recorded delta
+    int transactionDepth = 0;             // Open transactions
+};
+
+} // namespace jnsc::juce_interface
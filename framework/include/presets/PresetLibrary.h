@@ -0,0 +1,514 @@
+// Jonssonic Plugin Framework
+// Preset library - memory-mapped preset index with background prefetch
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Preset to be written to a library file
+ * @param name Display name (also used for name search)
+ * @param tags Tag names (at most 64 distinct tags per library)
+ * @param state State chunk as produced by ParameterManager::saveState()
+ */
+struct PresetEntry {
+    juce::String name;
+    juce::StringArray tags;
+    juce::MemoryBlock state;
+};
+
+/**
+ * @brief Packed, memory-mapped preset library
+ *
+ * A library is a single file holding a fixed-size index followed by the preset
+ * names and state payloads. The file is memory-mapped, so opening it does not
+ * read or parse the presets, and name/tag searches scan the packed index in
+ * place. Tags are stored as a 64-bit mask per preset.
+ *
+ * A background thread copies the payloads around the current preset into a
+ * small cache, so stepping through presets (program changes, next/previous
+ * buttons) does not touch the disk on the message thread.
+ *
+ * File layout (little-endian):
+ * - Header: magic, version, numPresets, numTags, stringsOffset, stringsSize, payloadOffset, reserved (int32 each)
+ * - Tag records: {nameOffset, nameLength} (uint32 each) per tag
+ * - Preset records: {nameOffset, nameLength (uint32), tagMask (uint64), payloadOffset, payloadSize (uint32)}
+ * - String table (UTF-8), then payloads
+ *
+ * Example usage:
+ * @code
+ *   PresetLibrary presets;
+ *   presets.open(PresetLibrary::getDefaultFile(JucePlugin_Name));
+ *
+ *   // Program change (message thread):
+ *   presets.loadPreset(index, parameterManager);
+ *
+ *   // Search:
+ *   auto matches = presets.search("hall", presets.getTagMask({"Ambient"}));
+ * @endcode
+ */
+class PresetLibrary {
+  public:
+    /// Number of presets on each side of the current one kept in the cache
+    static constexpr int prefetchRadius = 2;
+
+    /// Default constructor
+    PresetLibrary() = default;
+
+    /// Destructor (stops the prefetch thread)
+    ~PresetLibrary() { close(); }
+
+    /**
+     * @brief Get the default library location for a plugin
+     * @param pluginName Plugin name (e.g., JucePlugin_Name)
+     * @return File in the user application data directory
+     */
+    static juce::File getDefaultFile(const juce::String& pluginName) {
+        return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+            .getChildFile("Jonssonic")
+            .getChildFile(pluginName)
+            .getChildFile("Presets.jpl");
+    }
+
+    /**
+     * @brief Write a library file
+     *
+     * Close any PresetLibrary that has the same file open before writing.
+     *
+     * @param file Destination file (replaced atomically)
+     * @param presets Presets in program order
+     * @return True on success
+     */
+    static bool write(const juce::File& file, const std::vector<PresetEntry>& presets);
+
+    /**
+     * @brief Map a library file and start the prefetch thread
+     * @param file Library file
+     * @return False if the file is missing or not a valid library
+     */
+    bool open(const juce::File& file);
+
+    /// Stop the prefetch thread and unmap the file
+    void close();
+
+    /// Check if a library is open
+    bool isOpen() const { return mappedFile != nullptr; }
+
+    /// Number of presets in the library
+    int size() const { return numPresets; }
+
+    /// Index of the most recently loaded preset (-1 if none)
+    int getCurrentIndex() const { return currentIndex; }
+
+    /**
+     * @brief Get preset name
+     * @param index Preset index
+     * @return Name, or an empty string if the index is out of range
+     */
+    juce::String getName(int index) const;
+
+    /**
+     * @brief Get the tag mask of a preset
+     * @param index Preset index
+     * @return Bit i is set if the preset has tag i (see getTagNames())
+     */
+    uint64_t getTags(int index) const;
+
+    /// Get all tag names in bit order
+    juce::StringArray getTagNames() const;
+
+    /**
+     * @brief Convert tag names to a mask for search()
+     * @param tags Tag names (case-insensitive, unknown tags are ignored)
+     * @return Tag mask
+     */
+    uint64_t getTagMask(const juce::StringArray& tags) const;
+
+    /**
+     * @brief Find presets by name and tags without loading them
+     * @param nameQuery Case-insensitive substring of the name (empty matches all)
+     * @param requiredTags Presets must have all of these tags (0 = any)
+     * @return Matching preset indices in library order
+     */
+    std::vector<int> search(const juce::String& nameQuery, uint64_t requiredTags = 0) const;
+
+    /**
+     * @brief Copy a preset's state chunk
+     *
+     * Served from the prefetch cache when possible.
+     *
+     * @param index Preset index
+     * @param destData Destination memory block
+     * @return False if the index is out of range
+     */
+    bool getState(int index, juce::MemoryBlock& destData) const;
+
+    /**
+     * @brief Load a preset into a ParameterManager and prefetch its neighbours
+     * @param index Preset index
+     * @param manager Parameter manager (or anything with loadState(const void*, int))
+     * @return False if the index is out of range
+     */
+    template <typename Manager>
+    bool loadPreset(int index, Manager& manager) {
+        juce::MemoryBlock state;
+        if (!getState(index, state))
+            return false;
+
+        manager.loadState(state.getData(), static_cast<int>(state.getSize()));
+        currentIndex = index;
+        prefetchAround(index);
+        return true;
+    }
+
+    /**
+     * @brief Ask the background thread to cache the presets around an index
+     * @param index Centre preset index
+     */
+    void prefetchAround(int index);
+
+  private:
+    static constexpr int magic = 0x4C504E4A; // "JNPL" read as little-endian int
+    static constexpr int formatVersion = 1;
+    static constexpr size_t headerSize = 32;
+    static constexpr size_t tagRecordSize = 8;
+    static constexpr size_t presetRecordSize = 24;
+    static constexpr int cacheSize = 2 * prefetchRadius + 1;
+
+    // Cached copy of a preset's state chunk
+    struct CacheSlot {
+        int index = -1;
+        juce::MemoryBlock data;
+    };
+
+    // Background thread filling the cache around prefetchCentre
+    class PrefetchThread : public juce::Thread {
+      public:
+        explicit PrefetchThread(PresetLibrary& library) : juce::Thread("PresetPrefetch"), owner(library) {}
+
+        void run() override {
+            while (!threadShouldExit()) {
+                wait(-1);
+                const int centre = owner.prefetchCentre.exchange(-1);
+                if (centre >= 0)
+                    owner.fillCache(centre, *this);
+            }
+        }
+
+      private:
+        PresetLibrary& owner;
+    };
+
+    // Pointer into the mapped file
+    const uint8_t* bytes(size_t offset) const { return static_cast<const uint8_t*>(mappedFile->getData()) + offset; }
+
+    // Little-endian field readers
+    uint32_t readU32(size_t offset) const { return juce::ByteOrder::littleEndianInt(bytes(offset)); }
+    uint64_t readU64(size_t offset) const { return juce::ByteOrder::littleEndianInt64(bytes(offset)); }
+
+    // Offset of a preset record
+    size_t presetRecord(int index) const {
+        const size_t tagRecords = static_cast<size_t>(numTags) * tagRecordSize;
+        return headerSize + tagRecords + static_cast<size_t>(index) * presetRecordSize;
+    }
+
+    // Check that every record points inside the file
+    bool validate() const;
+
+    // Copy a payload from the mapped file
+    void copyPayload(int index, juce::MemoryBlock& destData) const;
+
+    // Wrap an index into [0, numPresets)
+    int wrap(int index) const { return ((index % numPresets) + numPresets) % numPresets; }
+
+    // Fill the cache around a centre index (prefetch thread)
+    void fillCache(int centre, const juce::Thread& thread);
+
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile; // Mapped library file
+    int numPresets = 0;                                 // Number of preset records
+    int numTags = 0;                                    // Number of tag records
+    size_t stringsOffset = 0;                           // Start of the string table
+    size_t payloadOffset = 0;                           // Start of the payload section
+    int currentIndex = -1;                              // Most recently loaded preset
+
+    std::unique_ptr<PrefetchThread> prefetchThread; // Background cache filler
+    std::atomic<int> prefetchCentre{-1};            // Pending prefetch request (-1 = none)
+    juce::CriticalSection cacheLock;                // Guards cache (message and prefetch threads only)
+    std::array<CacheSlot, cacheSize> cache;         // Payloads around the current preset
+
+    JUCE_DECLARE_NON_COPYABLE(PresetLibrary)
+};
+
+//==============================================================================
+// Implementation
+//==============================================================================
+
+inline bool PresetLibrary::write(const juce::File& file, const std::vector<PresetEntry>& presets) {
+    // Collect distinct tags in order of first use
+    juce::StringArray tagNames;
+    for (const auto& preset : presets) {
+        for (const auto& tag : preset.tags)
+            tagNames.addIfNotAlreadyThere(tag, true);
+    }
+    jassert(tagNames.size() <= 64); // Tags are stored as a 64-bit mask
+    if (tagNames.size() > 64)
+        return false;
+
+    // String table: tag names, then preset names
+    juce::MemoryBlock strings;
+    auto addString = [&strings](const juce::String& text, juce::MemoryOutputStream& records) {
+        const auto utf8 = text.toUTF8();
+        const auto length = utf8.sizeInBytes() - 1;
+        records.writeInt(static_cast<int>(strings.getSize()));
+        records.writeInt(static_cast<int>(length));
+        strings.append(utf8.getAddress(), length);
+    };
+
+    juce::MemoryBlock records;
+    juce::MemoryOutputStream recordStream(records, false);
+    for (const auto& tag : tagNames)
+        addString(tag, recordStream);
+
+    size_t payloadSize = 0;
+    for (const auto& preset : presets) {
+        uint64_t tagMask = 0;
+        for (const auto& tag : preset.tags)
+            tagMask |= uint64_t{1} << tagNames.indexOf(tag, true);
+
+        addString(preset.name, recordStream);
+        recordStream.writeInt64(static_cast<juce::int64>(tagMask));
+        recordStream.writeInt(static_cast<int>(payloadSize));
+        recordStream.writeInt(static_cast<int>(preset.state.getSize()));
+        payloadSize += preset.state.getSize();
+    }
+    recordStream.flush();
+
+    const auto stringsOffset = headerSize + records.getSize();
+    const auto payloadStart = stringsOffset + strings.getSize();
+
+    juce::MemoryBlock data;
+    juce::MemoryOutputStream stream(data, false);
+    stream.writeInt(magic);
+    stream.writeInt(formatVersion);
+    stream.writeInt(static_cast<int>(presets.size()));
+    stream.writeInt(tagNames.size());
+    stream.writeInt(static_cast<int>(stringsOffset));
+    stream.writeInt(static_cast<int>(strings.getSize()));
+    stream.writeInt(static_cast<int>(payloadStart));
+    stream.writeInt(0); // Reserved
+    stream.write(records.getData(), records.getSize());
+    stream.write(strings.getData(), strings.getSize());
+    for (const auto& preset : presets)
+        stream.write(preset.state.getData(), preset.state.getSize());
+    stream.flush();
+
+    file.getParentDirectory().createDirectory();
+    return file.replaceWithData(data.getData(), data.getSize());
+}
+
+inline bool PresetLibrary::open(const juce::File& file) {
+    close();
+    if (!file.existsAsFile())
+        return false;
+
+    mappedFile = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+    if (mappedFile->getData() == nullptr || mappedFile->getSize() < headerSize ||
+        readU32(0) != static_cast<uint32_t>(magic) || readU32(4) > static_cast<uint32_t>(formatVersion)) {
+        mappedFile.reset();
+        return false;
+    }
+
+    numPresets = static_cast<int>(readU32(8));
+    numTags = static_cast<int>(readU32(12));
+    stringsOffset = readU32(16);
+    payloadOffset = readU32(24);
+
+    if (!validate()) {
+        jassertfalse; // Corrupt or truncated library
+        mappedFile.reset();
+        numPresets = numTags = 0;
+        return false;
+    }
+
+    prefetchThread = std::make_unique<PrefetchThread>(*this);
+    prefetchThread->startThread();
+    return true;
+}
+
+inline void PresetLibrary::close() {
+    if (prefetchThread) {
+        prefetchThread->signalThreadShouldExit();
+        prefetchThread->notify();
+        prefetchThread->stopThread(1000);
+        prefetchThread.reset();
+    }
+
+    {
+        const juce::ScopedLock lock(cacheLock);
+        for (auto& slot : cache) {
+            slot.index = -1;
+            slot.data.reset();
+        }
+    }
+
+    mappedFile.reset();
+    numPresets = numTags = 0;
+    currentIndex = -1;
+}
+
+inline bool PresetLibrary::validate() const {
+    const size_t fileSize = mappedFile->getSize();
+    const size_t stringsSize = readU32(20);
+    if (numPresets < 0 || numTags < 0 || numTags > 64 || presetRecord(numPresets) > stringsOffset ||
+        stringsOffset + stringsSize > payloadOffset || payloadOffset > fileSize)
+        return false;
+
+    for (int i = 0; i < numTags; ++i) {
+        const size_t record = headerSize + static_cast<size_t>(i) * tagRecordSize;
+        if (static_cast<size_t>(readU32(record)) + readU32(record + 4) > stringsSize)
+            return false;
+    }
+
+    for (int i = 0; i < numPresets; ++i) {
+        const size_t record = presetRecord(i);
+        if (static_cast<size_t>(readU32(record)) + readU32(record + 4) > stringsSize)
+            return false;
+        if (payloadOffset + readU32(record + 16) + readU32(record + 20) > fileSize)
+            return false;
+    }
+    return true;
+}
+
+inline juce::String PresetLibrary::getName(int index) const {
+    if (index < 0 || index >= numPresets)
+        return {};
+    const size_t record = presetRecord(index);
+    return juce::String::fromUTF8(reinterpret_cast<const char*>(bytes(stringsOffset + readU32(record))),
+                                  static_cast<int>(readU32(record + 4)));
+}
+
+inline uint64_t PresetLibrary::getTags(int index) const {
+    if (index < 0 || index >= numPresets)
+        return 0;
+    return readU64(presetRecord(index) + 8);
+}
+
+inline juce::StringArray PresetLibrary::getTagNames() const {
+    juce::StringArray names;
+    for (int i = 0; i < numTags; ++i) {
+        const size_t record = headerSize + static_cast<size_t>(i) * tagRecordSize;
+        names.add(juce::String::fromUTF8(reinterpret_cast<const char*>(bytes(stringsOffset + readU32(record))),
+                                         static_cast<int>(readU32(record + 4))));
+    }
+    return names;
+}
+
+inline uint64_t PresetLibrary::getTagMask(const juce::StringArray& tags) const {
+    const auto names = getTagNames();
+    uint64_t mask = 0;
+    for (const auto& tag : tags) {
+        const int bit = names.indexOf(tag, true);
+        if (bit >= 0)
+            mask |= uint64_t{1} << bit;
+    }
+    return mask;
+}
+
+inline std::vector<int> PresetLibrary::search(const juce::String& nameQuery, uint64_t requiredTags) const {
+    // Compare UTF-8 bytes directly against the mapped string table (ASCII case folding)
+    const auto query = nameQuery.toLowerCase().toUTF8();
+    const auto* queryBegin = reinterpret_cast<const uint8_t*>(query.getAddress());
+    const auto* queryEnd = queryBegin + query.sizeInBytes() - 1;
+    auto equalsIgnoreCase = [](uint8_t a, uint8_t b) { return (a >= 'A' && a <= 'Z' ? a + 32 : a) == b; };
+
+    std::vector<int> matches;
+    for (int i = 0; i < numPresets; ++i) {
+        const size_t record = presetRecord(i);
+        if ((readU64(record + 8) & requiredTags) != requiredTags)
+            continue;
+
+        const auto* nameBegin = bytes(stringsOffset + readU32(record));
+        const auto* nameEnd = nameBegin + readU32(record + 4);
+        if (queryBegin == queryEnd ||
+            std::search(nameBegin, nameEnd, queryBegin, queryEnd, equalsIgnoreCase) != nameEnd)
+            matches.push_back(i);
+    }
+    return matches;
+}
+
+inline void PresetLibrary::copyPayload(int index, juce::MemoryBlock& destData) const {
+    const size_t record = presetRecord(index);
+    destData.replaceAll(bytes(payloadOffset + readU32(record + 16)), readU32(record + 20));
+}
+
+inline bool PresetLibrary::getState(int index, juce::MemoryBlock& destData) const {
+    if (index < 0 || index >= numPresets)
+        return false;
+
+    {
+        const juce::ScopedLock lock(cacheLock);
+        for (const auto& slot : cache) {
+            if (slot.index == index) {
+                destData = slot.data;
+                return true;
+            }
+        }
+    }
+
+    // Not prefetched yet (e.g., first load or a jump): read from the mapping
+    copyPayload(index, destData);
+    return true;
+}
+
+inline void PresetLibrary::prefetchAround(int index) {
+    if (prefetchThread == nullptr || numPresets == 0)
+        return;
+    prefetchCentre.store(wrap(index));
+    prefetchThread->notify();
+}
+
+inline void PresetLibrary::fillCache(int centre, const juce::Thread& thread) {
+    std::array<CacheSlot, cacheSize> next;
+    for (int k = 0; k < cacheSize; ++k) {
+        auto& slot = next[static_cast<size_t>(k)];
+        slot.index = wrap(centre + k - prefetchRadius);
+
+        // Reuse payloads that are already cached
+        bool found = false;
+        {
+            const juce::ScopedLock lock(cacheLock);
+            for (auto& cached : cache) {
+                if (cached.index == slot.index) {
+                    slot.data = cached.data;
+                    found = true;
+                    break;
+                }
+            }
+        }
+
+        // Page faults happen here, on the prefetch thread
+        if (!found)
+            copyPayload(slot.index, slot.data);
+
+        if (thread.threadShouldExit())
+            return;
+    }
+
+    const juce::ScopedLock lock(cacheLock);
+    for (size_t k = 0; k < cache.size(); ++k) {
+        cache[k].index = next[k].index;
+        cache[k].data.swapWith(next[k].data);
+    }
+}
+
+} // namespace jnsc::juce_interface
@@ -0,0 +1,97 @@
+// Jonssonic Plugin Framework
+// Channel fan-out - process mono input once and copy it to all outputs
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "ChannelView.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Runs channel-independent DSP once for mono-into-multichannel layouts
+ *
+ * With a mono input bus and a stereo (or wider) output bus, every output
+ * channel would carry a copy of the same signal, so running the DSP on each
+ * copy only repeats identical work. In that layout the DSP is prepared for a
+ * single channel, processes channel 0 and the result is copied to the other
+ * outputs. Other layouts run the DSP on all output channels as before.
+ *
+ * The input is mapped to the outputs through a ChannelView, so matching
+ * layouts are processed in place without copying and only output channels
+ * without an input channel of their own are filled.
+ *
+ * Only for effects whose channels do not interact (filters, EQ, waveshapers);
+ * stereo effects such as ping-pong delays or reverbs must not use it.
+ *
+ * Example usage:
+ * @code
+ *   // prepareToPlay
+ *   fanOut.prepare(getTotalNumInputChannels(), getTotalNumOutputChannels());
+ *   filter.prepare(static_cast<size_t>(fanOut.getNumProcessChannels()), sampleRate);
+ *
+ *   // processBlock (channels hold the input in the first input channels)
+ *   fanOut.process(channels, numSamples, [&](float* const* ch, int numCh, int n) {
+ *       filter.processBlock(ch, ch, static_cast<size_t>(n));
+ *   });
+ * @endcode
+ */
+class ChannelFanOut {
+  public:
+    /// Default constructor
+    ChannelFanOut() = default;
+
+    /**
+     * @brief Detect the layout (call in prepareToPlay, before preparing the DSP)
+     * @param numInputChannels Number of input channels
+     * @param numOutputChannels Number of output channels
+     */
+    void prepare(int numInputChannels, int numOutputChannels) {
+        numInputs = std::max(0, numInputChannels);
+        numOutputs = std::max(0, numOutputChannels);
+        monoInput = numInputs == 1 && numOutputs > 1;
+        floatView.prepare(numOutputs);
+        doubleView.prepare(numOutputs);
+    }
+
+    /// Check if the layout is mono into several outputs (DSP runs on one channel)
+    bool isMonoInput() const { return monoInput; }
+
+    /// Get the number of channels the DSP must be prepared for
+    int getNumProcessChannels() const { return monoInput ? 1 : numOutputs; }
+
+    /**
+     * @brief Map the input to the outputs and process a block in place (audio thread)
+     * @param channels Channel pointers (input in the first input channels, output in all)
+     * @param numSamples Number of samples
+     * @param fn Callable invoked as fn(SampleType* const* channels, int numChannels, int numSamples)
+     */
+    template <typename SampleType, typename ProcessFn>
+    void process(SampleType* const* channels, int numSamples, ProcessFn&& fn) {
+        auto& view = getView<SampleType>();
+        view.map(channels, numInputs, numOutputs, numSamples);
+        fn(view.getWritePointers(getNumProcessChannels()), getNumProcessChannels(), numSamples);
+        view.fanOut();
+    }
+
+  private:
+    template <typename SampleType>
+    ChannelView<SampleType>& getView() {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doubleView;
+        else
+            return floatView;
+    }
+
+    ChannelView<float> floatView;   // Zero-copy input-to-output mapping (float blocks)
+    ChannelView<double> doubleView; // Zero-copy input-to-output mapping (double blocks)
+    int numInputs = 0;              // Input channels of the current layout
+    int numOutputs = 0;             // Output channels of the current layout
+    bool monoInput = false;         // Mono input into several outputs
+};
+
+} // namespace jnsc::juce_interface
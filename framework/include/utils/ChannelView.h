@@ -0,0 +1,164 @@
+// Jonssonic Plugin Framework
+// Channel view - zero-copy input-to-output channel mapping with copy-on-write
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Maps output channels onto input channels without copying samples
+ *
+ * Jonssonic DSP expects one input channel per output channel. Instead of
+ * copying the input into every output channel each block, the view points
+ * each output channel at the input channel it reads from: its own channel
+ * when there is one, otherwise the last input channel (mono input feeds
+ * every output). Matching layouts processed in place cost nothing.
+ *
+ * Aliased channels are copied only when written (copy-on-write): asking for
+ * a write pointer to an aliased channel copies its source into it first, and
+ * writing to a source channel first copies it into the channels still
+ * aliasing it, so they keep the unprocessed input.
+ *
+ * Example usage:
+ * @code
+ *   // prepareToPlay
+ *   channelView.prepare(getTotalNumOutputChannels());
+ *
+ *   // processBlock (channels hold the input in the first numInputChannels)
+ *   channelView.map(channels, numInputChannels, numOutputChannels, numSamples);
+ *   compressor.processBlock(channelView.getReadPointers(),  // Reads the host buffer directly
+ *                           channelView.getReadPointers(),  // Detector input
+ *                           channelView.getWritePointers(), // Copies only aliased channels
+ *                           static_cast<size_t>(numSamples));
+ * @endcode
+ *
+ * Pointer arrays are allocated in prepare(); map() and the accessors never
+ * allocate, so they are safe on the audio thread.
+ *
+ * @tparam SampleType Sample type (float or double)
+ */
+template <typename SampleType = float>
+class ChannelView {
+  public:
+    /// Default constructor
+    ChannelView() = default;
+
+    /**
+     * @brief Allocate the pointer tables (call in prepareToPlay)
+     * @param maxChannels Maximum number of output channels
+     */
+    void prepare(int maxChannels) {
+        const auto size = static_cast<size_t>(std::max(0, maxChannels));
+        outputs.assign(size, nullptr);
+        inputs.assign(size, nullptr);
+        sources.assign(size, own);
+        numChannels = 0;
+    }
+
+    /**
+     * @brief Map the output channels of a block onto its input channels (audio thread)
+     * @param channels Channel pointers (input in the first numInputChannels, output in all)
+     * @param numInputChannels Number of input channels
+     * @param numOutputChannels Number of output channels (at most the prepared number)
+     * @param numSamples Number of samples
+     */
+    void map(SampleType* const* channels, int numInputChannels, int numOutputChannels, int numSamples) {
+        numChannels = std::min(numOutputChannels, static_cast<int>(outputs.size()));
+        blockSize = numSamples;
+        if (numInputChannels <= 0) {
+            numChannels = 0;
+            return;
+        }
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+            const auto c = static_cast<size_t>(ch);
+            const int source = ch < numInputChannels ? own : numInputChannels - 1;
+            outputs[c] = channels[ch];
+            inputs[c] = channels[source == own ? ch : source];
+            sources[c] = source;
+        }
+    }
+
+    /// Get the number of mapped channels
+    int getNumChannels() const { return numChannels; }
+
+    /// Check if a channel still reads another channel's samples
+    bool isAliased(int channel) const { return sources[static_cast<size_t>(channel)] != own; }
+
+    /// Get the input pointers, aliased channels pointing at their source (no copy)
+    const SampleType* const* getReadPointers() const { return inputs.data(); }
+
+    /**
+     * @brief Get a write pointer to a channel, copying on write
+     *
+     * An aliased channel receives a copy of its source; a source channel is
+     * first copied into the channels still aliasing it.
+     *
+     * @param channel Channel index
+     * @return Pointer to the channel's own samples
+     */
+    SampleType* getWritePointer(int channel) {
+        const auto c = static_cast<size_t>(channel);
+        if (sources[c] != own) {
+            detach(channel);
+        } else {
+            for (int ch = 0; ch < numChannels; ++ch) {
+                if (sources[static_cast<size_t>(ch)] == channel)
+                    detach(ch);
+            }
+        }
+        return outputs[c];
+    }
+
+    /**
+     * @brief Get write pointers to the first channels
+     *
+     * Channels beyond numWriteChannels that alias a written channel are left
+     * aliased and follow the processed signal; fanOut() copies it into them.
+     * This is how mono input into several outputs is processed only once.
+     *
+     * @param numWriteChannels Number of channels to make writable (-1 = all)
+     * @return Channel pointers, each to the channel's own samples
+     */
+    SampleType* const* getWritePointers(int numWriteChannels = -1) {
+        const int count = numWriteChannels < 0 ? numChannels : std::min(numWriteChannels, numChannels);
+        for (int ch = 0; ch < count; ++ch) {
+            if (sources[static_cast<size_t>(ch)] != own)
+                detach(ch);
+        }
+        return outputs.data();
+    }
+
+    /// Copy the (processed) source channel into every channel still aliasing it
+    void fanOut() {
+        for (int ch = 0; ch < numChannels; ++ch) {
+            if (sources[static_cast<size_t>(ch)] != own)
+                detach(ch);
+        }
+    }
+
+  private:
+    static constexpr int own = -1; // Channel reads its own samples
+
+    // Give a channel its own copy of its source's samples
+    void detach(int channel) {
+        const auto c = static_cast<size_t>(channel);
+        const auto source = static_cast<size_t>(sources[c]);
+        std::copy_n(outputs[source], blockSize, outputs[c]);
+        inputs[c] = outputs[c];
+        sources[c] = own;
+    }
+
+    std::vector<SampleType*> outputs;      // Output channel pointers (each channel's own samples)
+    std::vector<const SampleType*> inputs; // Input pointer per output channel (aliased or own)
+    std::vector<int> sources;              // Source channel per output channel (own = not aliased)
+    int numChannels = 0;                   // Mapped channels
+    int blockSize = 0;                     // Samples per channel of the mapped block
+};
+
+} // namespace jnsc::juce_interface
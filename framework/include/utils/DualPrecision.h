@@ -0,0 +1,85 @@
+// Jonssonic Plugin Framework
+// Dual precision - float and double instances of a processor, one active
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Holds a processor in float and double precision and routes calls to the active one
+ *
+ * Hosts with a 64-bit mix engine call processBlock(AudioBuffer<double>&) on
+ * plugins that support double precision, instead of converting every buffer
+ * to float and back. The plugin keeps its DSP as an engine template (the DSP
+ * objects and their scratch for one sample type) and selects the precision
+ * the host asked for in prepareToPlay. Only the active engine is prepared, so
+ * the other one holds no audio buffers.
+ *
+ * Example usage:
+ * @code
+ *   template <typename SampleType>
+ *   struct Engine {
+ *       jnsc::effects::Chorus<SampleType> chorus;
+ *   };
+ *   DualPrecision<Engine> engines;
+ *
+ *   // prepareToPlay
+ *   engines.setDoublePrecision(isUsingDoublePrecision());
+ *   engines.visit([&](auto& e) { e.chorus.prepare(numChannels, sampleRate); });
+ *
+ *   // Parameter callbacks
+ *   engines.visit([&](auto& e) { e.chorus.setRate(value, skipSmoothing); });
+ *
+ *   // processBlock(juce::AudioBuffer<SampleType>&, ...)
+ *   auto& engine = engines.get<SampleType>();
+ * @endcode
+ *
+ * @tparam Engine Class template taking the sample type
+ */
+template <template <typename> class Engine>
+class DualPrecision {
+  public:
+    /// Default constructor
+    DualPrecision() = default;
+
+    /**
+     * @brief Select the active precision (call in prepareToPlay, before preparing the engine)
+     * @param shouldUseDouble True to process in double precision
+     */
+    void setDoublePrecision(bool shouldUseDouble) { useDouble = shouldUseDouble; }
+
+    /// Check if double precision is active
+    bool isDoublePrecision() const { return useDouble; }
+
+    /// Get the engine of a sample type (float or double)
+    template <typename SampleType>
+    Engine<SampleType>& get() {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doubleEngine;
+        else
+            return floatEngine;
+    }
+
+    /**
+     * @brief Call a function on the active engine
+     * @param fn Generic callable invoked as fn(Engine<float>&) or fn(Engine<double>&)
+     * @return The result, converted to the type returned for the float engine
+     */
+    template <typename Fn>
+    auto visit(Fn&& fn) -> decltype(fn(std::declval<Engine<float>&>())) {
+        if (useDouble)
+            return std::forward<Fn>(fn)(doubleEngine);
+        return std::forward<Fn>(fn)(floatEngine);
+    }
+
+  private:
+    Engine<float> floatEngine;   // Used by processBlock(AudioBuffer<float>&)
+    Engine<double> doubleEngine; // Used by processBlock(AudioBuffer<double>&)
+    bool useDouble = false;      // Precision selected in prepareToPlay
+};
+
+} // namespace jnsc::juce_interface
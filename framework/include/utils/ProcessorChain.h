@@ -0,0 +1,246 @@
+// Jonssonic Plugin Framework
+// Processor chain - compile-time effect chain with chunked, fused processing
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "SampleType.h"
+#include "ScratchArena.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief View of one chunk handed to the stages of a ProcessorChain
+ * @tparam SampleType Sample type (float or double)
+ */
+template <typename SampleType>
+struct ChainBlock {
+    SampleType* const* wet;       // Working signal, processed in place (cache-resident scratch)
+    const SampleType* const* dry; // Unprocessed input of the chunk, one pointer per output channel
+    int numChannels;              // Number of channels
+    int numSamples;               // Number of samples in the chunk
+};
+
+/**
+ * @brief Block stage running a DSP object in place on the wet signal
+ * @tparam T DSP type with processBlock(const S* const* in, S* const* out, size_t numSamples), S its sample type
+ */
+template <typename T>
+struct EffectStage {
+    using SampleType = typename SampleTypeOf<T>::type;
+    EffectStage(T& processor) : dsp(processor) {}
+    void process(const ChainBlock<SampleType>& block) {
+        dsp.processBlock(block.wet, block.wet, static_cast<size_t>(block.numSamples));
+    }
+    T& dsp;
+};
+
+/**
+ * @brief Block stage mixing the dry input into the wet signal
+ * @tparam T Mixer type with processBlock(const S* const* dry, const S* const* wet, S* const* out, size_t)
+ */
+template <typename T>
+struct MixStage {
+    using SampleType = typename SampleTypeOf<T>::type;
+    MixStage(T& mixer) : dsp(mixer) {}
+    void process(const ChainBlock<SampleType>& block) {
+        dsp.processBlock(block.dry, block.wet, block.wet, static_cast<size_t>(block.numSamples));
+    }
+    T& dsp;
+};
+
+/**
+ * @brief Sample stage wrapping a callable (consecutive sample stages are fused into one loop)
+ * @tparam Fn Callable invoked as fn(int channel, SampleType wet, SampleType dry) returning the new wet sample
+ * @tparam Sample Sample type (float or double)
+ */
+template <typename Fn, typename Sample = float>
+struct SampleStage {
+    using SampleType = Sample;
+    SampleType processSample(int channel, SampleType wet, SampleType dry) { return fn(channel, wet, dry); }
+    Fn fn;
+};
+
+/// Create a SampleStage from a callable
+template <typename SampleType = float, typename Fn>
+SampleStage<std::decay_t<Fn>, SampleType> makeSampleStage(Fn&& fn) {
+    return {std::forward<Fn>(fn)};
+}
+
+/**
+ * @brief Effect chain composed at compile time and run over cache-sized chunks
+ *
+ * Instead of one full-block pass per stage (map the input into an effect
+ * buffer, run the effect, mix), the chain walks the block in short chunks
+ * and runs every stage on a chunk before moving on, so intermediate signals
+ * stay in a chunk-sized scratch buffer that lives in cache. The scratch is
+ * borrowed from the instance's ScratchArena for the duration of process(). Stages that work
+ * sample by sample (those with processSample()) are fused: consecutive ones
+ * run in a single loop, and a trailing run writes straight to the output.
+ *
+ * Stages are either block stages, with process(const ChainBlock<SampleType>&),
+ * or sample stages, with SampleType processSample(int channel, SampleType wet,
+ * SampleType dry). All stages share one sample type (float or double), taken
+ * from the DSP types (e.g., Chorus<double> runs a double chain).
+ *
+ * Example usage:
+ * @code
+ *   using Chorus = jnsc::effects::Chorus<float>;
+ *   using Mixer = jnsc::DryWetMixer<float>;
+ *
+ *   Chorus chorus;
+ *   Mixer dryWetMixer;
+ *   ProcessorChain<EffectStage<Chorus>, MixStage<Mixer>> chain{chorus, dryWetMixer};
+ *
+ *   chain.prepare(numChannels, scratchArena);                           // prepareToPlay
+ *   chain.process(channels, numInputChannels, numChannels, numSamples); // processBlock (in place)
+ * @endcode
+ *
+ * @tparam Stages Stage types, in processing order
+ */
+template <typename... Stages>
+class ProcessorChain {
+  public:
+    /// Sample type of the chain (shared by all stages)
+    using SampleType = typename std::tuple_element_t<0, std::tuple<Stages...>>::SampleType;
+    static_assert((std::is_same_v<SampleType, typename Stages::SampleType> && ...),
+                  "All stages of a ProcessorChain must use the same sample type");
+
+    /// Default chunk length in samples (a stereo chunk of scratch fits easily in L1 cache)
+    static constexpr int defaultChunkSize = 64;
+
+    /// Construct from the stages (e.g., DSP references converting to EffectStage/MixStage)
+    ProcessorChain(Stages... chainStages) : stages(std::move(chainStages)...) {}
+
+    /**
+     * @brief Reserve scratch memory (call in prepareToPlay)
+     * @param numChannels Number of output channels
+     * @param arena Arena the wet and dry scratch is borrowed from while processing
+     * @param newChunkSize Chunk length in samples
+     */
+    void prepare(int numChannels, ScratchArena& arena, int newChunkSize = defaultChunkSize) {
+        chunkSize = std::max(1, newChunkSize);
+        scratchArena = &arena;
+        scratchArena->reserve(2 * ScratchArena::bytesFor<SampleType>(numChannels, chunkSize));
+        dryPointers.resize(static_cast<size_t>(numChannels));
+        outPointers.resize(static_cast<size_t>(numChannels));
+    }
+
+    /// Get a stage
+    template <size_t Index>
+    auto& getStage() {
+        return std::get<Index>(stages);
+    }
+
+    /**
+     * @brief Process a block in place (audio thread)
+     *
+     * Output channels beyond the input channels take the last input channel
+     * (mono input feeds every output).
+     *
+     * @param channels Channel pointers (input in the first numInputChannels, output in all)
+     * @param numInputChannels Number of input channels
+     * @param numOutputChannels Number of output channels (at most the prepared number)
+     * @param numSamples Number of samples
+     */
+    void process(SampleType* const* channels, int numInputChannels, int numOutputChannels, int numSamples) {
+        const int numCh = std::min(numOutputChannels, static_cast<int>(outPointers.size()));
+        if (numCh <= 0 || numInputChannels <= 0)
+            return;
+
+        auto wetScratch = scratchArena->allocate<SampleType>(numCh, chunkSize);
+        auto dryScratch = scratchArena->allocate<SampleType>(numCh, chunkSize);
+        if (!wetScratch.isValid() || !dryScratch.isValid())
+            return;
+        SampleType* const* wetPointers = wetScratch.getWritePointers();
+
+        for (int start = 0; start < numSamples; start += chunkSize) {
+            const int length = std::min(chunkSize, numSamples - start);
+            for (int ch = 0; ch < numCh; ++ch) {
+                const auto c = static_cast<size_t>(ch);
+                const SampleType* input = channels[std::min(ch, numInputChannels - 1)] + start;
+                outPointers[c] = channels[ch] + start;
+                std::copy_n(input, length, wetPointers[c]);
+
+                // A channel reading another channel's input needs its own copy, as that input is overwritten
+                if (ch < numInputChannels) {
+                    dryPointers[c] = input;
+                } else {
+                    SampleType* dry = dryScratch.getWritePointer(ch);
+                    std::copy_n(input, length, dry);
+                    dryPointers[c] = dry;
+                }
+            }
+
+            const ChainBlock<SampleType> block{wetPointers, dryPointers.data(), numCh, length};
+            runStage<0>(block);
+        }
+    }
+
+  private:
+    static constexpr size_t numStages = sizeof...(Stages);
+
+    template <typename S, typename = void>
+    struct IsSampleStage : std::false_type {};
+
+    template <typename S>
+    struct IsSampleStage<S, std::void_t<decltype(std::declval<S&>().processSample(0, SampleType{}, SampleType{}))>>
+        : std::true_type {};
+
+    static constexpr std::array<bool, numStages + 1> sampleStageFlags{IsSampleStage<Stages>::value..., false};
+
+    // One past the last stage of the sample-stage run starting at Index
+    static constexpr size_t sampleRunEnd(size_t index) {
+        while (index < numStages && sampleStageFlags[index])
+            ++index;
+        return index;
+    }
+
+    template <size_t Index>
+    void runStage(const ChainBlock<SampleType>& block) {
+        if constexpr (Index == numStages) {
+            for (int ch = 0; ch < block.numChannels; ++ch)
+                std::copy_n(block.wet[ch], block.numSamples, outPointers[static_cast<size_t>(ch)]);
+        } else if constexpr (sampleStageFlags[Index]) {
+            constexpr size_t end = sampleRunEnd(Index);
+            runSampleStages<Index>(block, std::make_index_sequence<end - Index>{});
+            if constexpr (end < numStages)
+                runStage<end>(block);
+        } else {
+            std::get<Index>(stages).process(block);
+            runStage<Index + 1>(block);
+        }
+    }
+
+    // Fused loop over consecutive sample stages; a trailing run writes the output directly
+    template <size_t First, size_t... Offsets>
+    void runSampleStages(const ChainBlock<SampleType>& block, std::index_sequence<Offsets...>) {
+        constexpr bool isLast = First + sizeof...(Offsets) == numStages;
+        for (int ch = 0; ch < block.numChannels; ++ch) {
+            const SampleType* wet = block.wet[ch];
+            const SampleType* dry = block.dry[ch];
+            SampleType* out = isLast ? outPointers[static_cast<size_t>(ch)] : block.wet[ch];
+            for (int i = 0; i < block.numSamples; ++i) {
+                SampleType x = wet[i];
+                ((x = std::get<First + Offsets>(stages).processSample(ch, x, dry[i])), ...);
+                out[i] = x;
+            }
+        }
+    }
+
+    std::tuple<Stages...> stages;               // Stages in processing order
+    int chunkSize = defaultChunkSize;           // Chunk length in samples
+    ScratchArena* scratchArena = nullptr;       // Arena holding the wet and dry scratch (one chunk per channel each)
+    std::vector<const SampleType*> dryPointers; // Dry input of the current chunk
+    std::vector<SampleType*> outPointers;       // Output of the current chunk
+};
+
+} // namespace jnsc::juce_interface
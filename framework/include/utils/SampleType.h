@@ -0,0 +1,25 @@
+// Jonssonic Plugin Framework
+// Sample type - sample precision of DSP classes
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief Sample type of a DSP class templated on it (e.g., float for jnsc::effects::Chorus<float>)
+ *
+ * Takes the first template argument of the class; non-template classes
+ * process float.
+ */
+template <typename T>
+struct SampleTypeOf {
+    using type = float;
+};
+
+template <template <typename...> class Processor, typename SampleType, typename... Rest>
+struct SampleTypeOf<Processor<SampleType, Rest...>> {
+    using type = SampleType;
+};
+
+} // namespace jnsc::juce_interface
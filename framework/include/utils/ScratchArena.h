@@ -0,0 +1,203 @@
+// Jonssonic Plugin Framework
+// Scratch arena - per-instance stack of aligned temporary channel buffers
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace jnsc::juce_interface {
+
+/**
+ * @brief One memory block per plugin instance for temporary channel buffers
+ *
+ * Instead of every stage owning a block-sized buffer that stays allocated
+ * (and competes for cache) even while other stages run, the stages of an
+ * instance borrow their temporaries from a shared arena. The arena is sized
+ * once in prepareToPlay; during processBlock, allocate() hands out aligned
+ * channel buffers stack-fashion and each ScratchBuffer gives its memory back
+ * when it goes out of scope. Stages running one after another reuse the same
+ * memory, so the working set stays small.
+ *
+ * Each stage reserves what it holds at once; a stage that keeps scratch while
+ * calling another must reserve the sum of both. Sizes depend on the sample
+ * type, so float and double buffers are reserved with bytesFor<SampleType>().
+ *
+ * Example usage:
+ * @code
+ *   // prepareToPlay
+ *   scratchArena.reserve(ScratchArena::bytesFor(numChannels, maxBlockSize));
+ *
+ *   // processBlock
+ *   {
+ *       auto temp = scratchArena.allocate(numChannels, numSamples);
+ *       if (temp.isValid())
+ *           filter.processBlock(input, temp.getWritePointers(), numSamples);
+ *   } // Memory returned here
+ * @endcode
+ */
+class ScratchArena {
+  public:
+    /// Alignment of every channel buffer in bytes (cache line, and enough for any SIMD width)
+    static constexpr size_t alignment = 64;
+
+    /**
+     * @brief Temporary channel buffer borrowed from the arena (move-only, returned on destruction)
+     * @tparam SampleType Sample type (float or double)
+     */
+    template <typename SampleType>
+    class ScratchBuffer {
+      public:
+        ScratchBuffer() = default;
+        ScratchBuffer(ScratchBuffer&& other) noexcept { *this = std::move(other); }
+        ScratchBuffer& operator=(ScratchBuffer&& other) noexcept {
+            if (this != &other) {
+                release();
+                arena = std::exchange(other.arena, nullptr);
+                channels = std::exchange(other.channels, nullptr);
+                numChannels = std::exchange(other.numChannels, 0);
+                numSamples = std::exchange(other.numSamples, 0);
+                mark = other.mark;
+                end = other.end;
+            }
+            return *this;
+        }
+        ScratchBuffer(const ScratchBuffer&) = delete;
+        ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+        ~ScratchBuffer() { release(); }
+
+        /// Check if the allocation succeeded (false if the arena was too small)
+        bool isValid() const { return channels != nullptr; }
+
+        /// Get the channel pointers
+        SampleType* const* getWritePointers() const { return channels; }
+
+        /// Get the channel pointers for reading
+        const SampleType* const* getReadPointers() const { return channels; }
+
+        /// Get one channel
+        SampleType* getWritePointer(int channel) const { return channels[channel]; }
+
+        /// Get the number of channels
+        int getNumChannels() const { return numChannels; }
+
+        /// Get the number of samples per channel
+        int getNumSamples() const { return numSamples; }
+
+      private:
+        friend class ScratchArena;
+
+        void release() {
+            if (arena == nullptr)
+                return;
+            jassert(arena->top == end); // Scratch buffers must be released in reverse allocation order
+            arena->top = mark;
+            arena = nullptr;
+            channels = nullptr;
+        }
+
+        ScratchArena* arena = nullptr;   // Owning arena (nullptr = empty)
+        SampleType** channels = nullptr; // Channel pointers, stored in the arena
+        int numChannels = 0;             // Number of channels
+        int numSamples = 0;              // Samples per channel
+        size_t mark = 0;                 // Arena top before the allocation
+        size_t end = 0;                  // Arena top after the allocation
+    };
+
+    /// Default constructor
+    ScratchArena() = default;
+
+    /**
+     * @brief Get the arena bytes needed by one allocate() call
+     * @param numChannels Number of channels
+     * @param numSamples Samples per channel
+     * @tparam SampleType Sample type (float or double)
+     */
+    template <typename SampleType = float>
+    static constexpr size_t bytesFor(int numChannels, int numSamples) {
+        const auto channels = static_cast<size_t>(std::max(0, numChannels));
+        const auto samples = static_cast<size_t>(std::max(0, numSamples));
+        return align(channels * sizeof(SampleType*)) + channels * align(samples * sizeof(SampleType));
+    }
+
+    /**
+     * @brief Grow the arena to at least the given size (call in prepareToPlay)
+     * @param numBytes Bytes needed at once, e.g., a sum of bytesFor() results
+     */
+    void reserve(size_t numBytes) {
+        jassert(top == 0); // Not while scratch buffers are in use
+        if (numBytes <= capacity)
+            return;
+        storage.assign(numBytes + alignment, std::byte{0});
+        const auto address = reinterpret_cast<std::uintptr_t>(storage.data());
+        base = storage.data() + (align(static_cast<size_t>(address)) - static_cast<size_t>(address));
+        capacity = numBytes;
+    }
+
+    /// Free the arena memory (call in releaseResources)
+    void release() {
+        jassert(top == 0); // Not while scratch buffers are in use
+        storage.clear();
+        storage.shrink_to_fit();
+        base = nullptr;
+        capacity = 0;
+    }
+
+    /// Get the arena size in bytes
+    size_t getCapacity() const { return capacity; }
+
+    /// Get the bytes currently handed out
+    size_t getBytesInUse() const { return top; }
+
+    /**
+     * @brief Borrow a channel buffer (audio thread, never allocates)
+     *
+     * The contents are not cleared. Returns an invalid buffer (and asserts)
+     * if the arena is too small for the request.
+     *
+     * @param numChannels Number of channels
+     * @param numSamples Samples per channel
+     * @tparam SampleType Sample type (float or double)
+     */
+    template <typename SampleType = float>
+    ScratchBuffer<SampleType> allocate(int numChannels, int numSamples) {
+        ScratchBuffer<SampleType> buffer;
+        const size_t size = bytesFor<SampleType>(numChannels, numSamples);
+        if (size > capacity - top) {
+            jassertfalse; // Reserve more in prepareToPlay
+            return buffer;
+        }
+
+        std::byte* memory = base + top;
+        const size_t stride = align(static_cast<size_t>(std::max(0, numSamples)) * sizeof(SampleType));
+        auto** channels = reinterpret_cast<SampleType**>(memory);
+        memory += align(static_cast<size_t>(std::max(0, numChannels)) * sizeof(SampleType*));
+        for (int ch = 0; ch < numChannels; ++ch, memory += stride)
+            channels[ch] = reinterpret_cast<SampleType*>(memory);
+
+        buffer.arena = this;
+        buffer.channels = channels;
+        buffer.numChannels = std::max(0, numChannels);
+        buffer.numSamples = std::max(0, numSamples);
+        buffer.mark = top;
+        top += size;
+        buffer.end = top;
+        return buffer;
+    }
+
+  private:
+    static constexpr size_t align(size_t numBytes) { return (numBytes + alignment - 1) & ~(alignment - 1); }
+
+    std::vector<std::byte> storage; // Arena memory (with room to align the base)
+    std::byte* base = nullptr;      // First aligned byte of storage
+    size_t capacity = 0;            // Usable bytes from base
+    size_t top = 0;                 // Bytes handed out (stack top)
+};
+
+} // namespace jnsc::juce_interface
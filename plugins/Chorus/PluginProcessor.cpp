@@ -2,9 +2,11 @@
 #include "PluginEditor.h"
 #include <JuceHeader.h>
 #include <iostream>
-#include <jonssonic/utils/buffer_utils.h>
 
-ChorusAudioProcessor::ChorusAudioProcessor() : parameterManager(ChorusParams().createParams(), *this) {
+// Parameter definitions, evaluated at compile time (no heap allocation)
+static constexpr auto parameters = ChorusParams::createParams();
+
+ChorusAudioProcessor::ChorusAudioProcessor() : parameterManager(parameters, *this) {
     // ============================================================================
     // [DEBUG]: Prints all APVTS parameter IDs at startup
     // This helps verify that your parameters are registered correctly.
@@ -18,50 +20,67 @@ ChorusAudioProcessor::ChorusAudioProcessor() : parameterManager(ChorusParams().c
     }
     // ============================================================================
 
+    // Map the preset library; without one the plugin exposes a single default program
+    presetLibrary.open(jnsc::juce_interface::PresetLibrary::getDefaultFile(JucePlugin_Name));
+
     // Register callbacks for parameter changes
     using ID = ChorusParams::ID;
 
     parameterManager.on(ID::Rate, [this](float value, bool skipSmoothing) {
         DBG("[DEBUG] Rate changed: " + juce::String(value) + ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        chorus.setRate(value, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.chorus.setRate(value, skipSmoothing); });
     });
 
     parameterManager.on(ID::Depth, [this](float value, bool skipSmoothing) {
         DBG("[DEBUG] Depth changed: " + juce::String(value) + ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        chorus.setDepth(value * 0.01f, skipSmoothing); // We are converting from [0,100] to [0,1]
+        // We are converting from [0,100] to [0,1]
+        engines.visit([&](auto& dsp) { dsp.chorus.setDepth(value * 0.01f, skipSmoothing); });
     });
 
     parameterManager.on(ID::Spread, [this](float value, bool skipSmoothing) {
         DBG("[DEBUG] Spread changed: " + juce::String(value) +
             ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        chorus.setSpread(value * 0.01f, skipSmoothing); // We are converting from [0,100] to [0,1]
+        // We are converting from [0,100] to [0,1]
+        engines.visit([&](auto& dsp) { dsp.chorus.setSpread(value * 0.01f, skipSmoothing); });
     });
 
     parameterManager.on(ID::Delay, [this](float value, bool skipSmoothing) {
         DBG("[DEBUG] Delay changed: " + juce::String(value) + ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        chorus.setDelayMs(value, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.chorus.setDelayMs(value, skipSmoothing); });
     });
 
     parameterManager.on(ID::Feedback, [this](float value, bool skipSmoothing) {
         DBG("[DEBUG] Feedback changed: " + juce::String(value) +
             ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        chorus.setFeedback(value * 0.01f, skipSmoothing); // We are converting from [0,100] to [0,1]
+        // We are converting from [0,100] to [0,1]
+        engines.visit([&](auto& dsp) { dsp.chorus.setFeedback(value * 0.01f, skipSmoothing); });
     });
 
-    parameterManager.on(ID::Mix, [this](float value, bool skipSmoothing) {
-        DBG("[DEBUG] Mix changed: " + juce::String(value) + ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        dryWetMixer.setMix(value * 0.01f); // We are converting from [0,100] to [0,1]
+    parameterManager.on(ID::Mix, [this](float value, bool /*skipSmoothing*/) {
+        // We are converting from [0,100] to [0,1]
+        engines.visit([&](auto& dsp) { dsp.dryWetMixer.setMix(value * 0.01f); });
     });
 }
 
 ChorusAudioProcessor::~ChorusAudioProcessor() {}
 
 void ChorusAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
+    // Process in fixed internal blocks for consistent cache use with any host block size
+    parameterManager.setMaxSubBlockSize(internalBlockSize);
+
+    // Run the DSP natively in the precision the host processes in
+    engines.setDoublePrecision(isUsingDoublePrecision());
+
     auto numChannels = static_cast<size_t>(getTotalNumOutputChannels());
     // Prepare all DSP objects and buffers here
-    dryWetMixer.prepare(numChannels, static_cast<float>(sampleRate));
-    fxBuffer.resize(numChannels, static_cast<size_t>(samplesPerBlock));
-    chorus.prepare(numChannels, static_cast<float>(sampleRate));
+    engines.visit([&](auto& dsp) {
+        dsp.dryWetMixer.prepare(numChannels, static_cast<float>(sampleRate));
+        dsp.effectChain.prepare(static_cast<int>(numChannels), scratchArena);
+        dsp.chorus.prepare(numChannels, static_cast<float>(sampleRate));
+    });
+
+    // Prepare framework parameter smoothing (FloatParams with a smoothing time in Params.h)
+    parameterManager.prepare(sampleRate);
 
     // Initialize DSP with parameter defaults (defined in Params.h) (skip smoothing for instant setup)
     parameterManager.syncAll(true);
@@ -69,12 +88,27 @@ void ChorusAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 
 void ChorusAudioProcessor::releaseResources() {
     // Release DSP resources here
-    dryWetMixer.reset();
-    fxBuffer.resize(0, 0);
-    chorus.reset();
+    engines.visit([](auto& dsp) {
+        dsp.dryWetMixer.reset();
+        dsp.chorus.reset();
+    });
+    scratchArena.release();
 }
 
 void ChorusAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    process(buffer, midiMessages);
+}
+
+void ChorusAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages) {
+    process(buffer, midiMessages);
+}
+
+bool ChorusAudioProcessor::supportsDoublePrecisionProcessing() const {
+    return true;
+}
+
+template <typename SampleType>
+void ChorusAudioProcessor::process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages) {
     // Get audio buffer info
     const int numInputChannels = getTotalNumInputChannels();
     const int numOutputChannels = getTotalNumOutputChannels();
@@ -83,29 +117,23 @@ void ChorusAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
     // Early return if no audio to process
     if (numInputChannels == 0 || numOutputChannels == 0 || numSamples == 0)
         return;
-    // Update all parameters from FIFO (GUI thread → Audio thread)
-    parameterManager.update();
 
     // Handle denormals
     juce::ScopedNoDenormals noDenormals;
 
-    // Note: Jonssonic DSP expects numInputChannels == numOutputChannels
-    // So we map the input channels to output channels accordingly
-    jnsc::utils::mapChannels<float>(
-        buffer.getArrayOfReadPointers(), // juce::AudioBuffer<float> uses getArrayOfReadPointers() for const access
-        fxBuffer.writePtrs(),            // Jonssonic::AudioBuffer<float> uses writePtrs() for non-const access
-        numInputChannels,
-        numOutputChannels,
-        numSamples);
+    // Turn learned MIDI CCs into sample-accurate parameter events
+    parameterManager.processMidi(midiMessages);
 
-    // Process the chorus effect
-    chorus.processBlock(fxBuffer.readPtrs(), fxBuffer.writePtrs(), static_cast<size_t>(numSamples));
+    // Process in sub-blocks split at timestamped parameter events (applies pending GUI/host changes first)
+    parameterManager.processSubBlocks(numSamples, [&](int startSample, int numSubSamples) {
+        // View into the host buffer for this sub-block (no copy, no allocation)
+        juce::AudioBuffer<SampleType> block(
+            buffer.getArrayOfWritePointers(), buffer.getNumChannels(), startSample, numSubSamples);
 
-    // Dry/wet processing
-    dryWetMixer.processBlock(buffer.getArrayOfReadPointers(),  // dry buffer
-                             fxBuffer.readPtrs(),              // wet buffer
-                             buffer.getArrayOfWritePointers(), // final output
-                             static_cast<size_t>(numSamples)); // number of samples
+        // Map inputs to outputs and run the chain in place (effect and mix per cache-sized chunk)
+        engines.get<SampleType>().effectChain.process(
+            block.getArrayOfWritePointers(), numInputChannels, numOutputChannels, numSubSamples);
+    });
 }
 
 void ChorusAudioProcessor::getStateInformation(juce::MemoryBlock& destData) {
@@ -136,14 +164,16 @@ double ChorusAudioProcessor::getTailLengthSeconds() const {
     return 0.0;
 }
 int ChorusAudioProcessor::getNumPrograms() {
-    return 1;
+    return juce::jmax(1, presetLibrary.size()); // Hosts expect at least one program
 }
 int ChorusAudioProcessor::getCurrentProgram() {
-    return 0;
+    return juce::jmax(0, presetLibrary.getCurrentIndex());
+}
+void ChorusAudioProcessor::setCurrentProgram(int index) {
+    presetLibrary.loadPreset(index, parameterManager);
 }
-void ChorusAudioProcessor::setCurrentProgram(int) {}
-const juce::String ChorusAudioProcessor::getProgramName(int) {
-    return {};
+const juce::String ChorusAudioProcessor::getProgramName(int index) {
+    return presetLibrary.getName(index);
 }
 void ChorusAudioProcessor::changeProgramName(int, const juce::String&) {}
 bool ChorusAudioProcessor::hasEditor() const {
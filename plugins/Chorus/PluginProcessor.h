@@ -6,6 +6,9 @@
 #include <jonssonic/core/mixing/dry_wet_mixer.h>
 #include <jonssonic/effects/chorus.h>
 #include <parameters/ParameterManager.h>
+#include <presets/PresetLibrary.h>
+#include <utils/DualPrecision.h>
+#include <utils/ProcessorChain.h>
 
 class ChorusAudioProcessor : public juce::AudioProcessor {
   public:
@@ -14,6 +17,8 @@ class ChorusAudioProcessor : public juce::AudioProcessor {
 
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
     void releaseResources() override;
 
     void getStateInformation(juce::MemoryBlock& destData) override;
@@ -38,12 +43,33 @@ class ChorusAudioProcessor : public juce::AudioProcessor {
     juce::AudioProcessorValueTreeState& getAPVTS() { return parameterManager.getAPVTS(); }
 
   private:
-    // DSP objects and buffers
-    jnsc::AudioBuffer<float> fxBuffer;    // Buffer for effect processing
-    jnsc::DryWetMixer<float> dryWetMixer; // Dry/wet mixer
-    jnsc::effects::Chorus<float> chorus;  // Chorus effect processor
+    // Process a block in the host's precision (float or double)
+    template <typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
+
+    // Fixed internal block size (the DSP never sees longer blocks, whatever the host sends)
+    static constexpr int internalBlockSize = 64;
+
+    // DSP objects of one sample precision (only the precision the host uses is prepared)
+    template <typename SampleType>
+    struct Engine {
+        jnsc::DryWetMixer<SampleType> dryWetMixer; // Dry/wet mixer
+        jnsc::effects::Chorus<SampleType> chorus;  // Chorus effect processor
+
+        // Effect chain (runs the chorus and the dry/wet mix chunk by chunk, in place)
+        jnsc::juce_interface::ProcessorChain<jnsc::juce_interface::EffectStage<jnsc::effects::Chorus<SampleType>>,
+                                             jnsc::juce_interface::MixStage<jnsc::DryWetMixer<SampleType>>>
+            effectChain{chorus, dryWetMixer};
+    };
+    jnsc::juce_interface::DualPrecision<Engine> engines; // Float and double DSP
+
+    // Scratch memory shared by the processing stages (sized in prepareToPlay)
+    jnsc::juce_interface::ScratchArena scratchArena;
 
     // Parameter manager
     jnsc::juce_interface::ParameterManager<ChorusParams::ID> parameterManager;
+
+    // Preset library (host programs)
+    jnsc::juce_interface::PresetLibrary presetLibrary;
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChorusAudioProcessor)
 };
\ No newline at end of file
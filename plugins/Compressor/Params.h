@@ -20,7 +20,7 @@ struct CompressorParams {
     };
 
     // Create parameter definitions
-    inline jnsc::juce_interface::ParameterSet<ID> createParams() {
+    static constexpr jnsc::juce_interface::ParameterSet<ID> createParams() {
         using namespace jnsc::juce_interface;
         ParameterSet<ID> params;
 
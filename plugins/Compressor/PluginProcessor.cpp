@@ -2,10 +2,12 @@
 #include "PluginEditor.h"
 #include <JuceHeader.h>
 #include <iostream>
-#include <jonssonic/utils/buffer_utils.h>
+
+// Parameter definitions, evaluated at compile time (no heap allocation)
+static constexpr auto parameters = CompressorParams::createParams();
 
 CompressorAudioProcessor::CompressorAudioProcessor()
-    : parameterManager(CompressorParams().createParams(), *this),
+    : parameterManager(parameters, *this),
       visualizerManager(CompressorVisualizers().createVisualizers()) {
     // ============================================================================
     // [DEBUG]: Prints all APVTS parameter IDs at startup
@@ -20,59 +22,74 @@ CompressorAudioProcessor::CompressorAudioProcessor()
     }
     // ============================================================================
 
+    // Map the preset library; without one the plugin exposes a single default program
+    presetLibrary.open(jnsc::juce_interface::PresetLibrary::getDefaultFile(JucePlugin_Name));
+
     // Register callbacks for parameter changes
     using ID = CompressorParams::ID;
 
     parameterManager.on(ID::Threshold, [this](float value, bool skipSmoothing) {
         DBG("[DEBUG] Threshold changed: " + juce::String(value) +
             ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        compressor.setThreshold(value, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.compressor.setThreshold(value, skipSmoothing); });
     });
 
     parameterManager.on(ID::Ratio, [this](int value, bool skipSmoothing) {
         DBG("[DEBUG] Ratio changed: " + juce::String(value) +
             ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        compressor.setRatio(static_cast<float>(value), skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.compressor.setRatio(static_cast<float>(value), skipSmoothing); });
     });
 
     parameterManager.on(ID::Knee, [this](float value, bool skipSmoothing) {
         DBG("[DEBUG] Knee changed: " + juce::String(value) +
             ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        compressor.setKnee(value, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.compressor.setKnee(value, skipSmoothing); });
     });
 
     parameterManager.on(ID::Attack, [this](float value, bool skipSmoothing) {
         DBG("[DEBUG] Attack changed: " + juce::String(value) +
             ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        compressor.setAttackTime(value, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.compressor.setAttackTime(value, skipSmoothing); });
     });
 
     parameterManager.on(ID::Release, [this](float value, bool skipSmoothing) {
         DBG("[DEBUG] Release changed: " + juce::String(value) +
             ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        compressor.setReleaseTime(value, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.compressor.setReleaseTime(value, skipSmoothing); });
     });
 
     parameterManager.on(ID::Output, [this](float value, bool skipSmoothing) {
         DBG("[DEBUG] Output changed: " + juce::String(value) +
             ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
         // Call your DSP output gain setter here
-        compressor.setOutputGain(value, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.compressor.setOutputGain(value, skipSmoothing); });
     });
 
     // Register visualizer value suppliers
     using VisualizerID = CompressorVisualizers::ID;
     visualizerManager.registerValueSupplier(VisualizerID::GainReduction, [this]() -> float {
-        return compressor.getGainReduction();
+        return engines.visit([](auto& dsp) { return static_cast<float>(dsp.compressor.getGainReduction()); });
     });
 }
 
 CompressorAudioProcessor::~CompressorAudioProcessor() {}
 
 void CompressorAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
+    // Process in fixed internal blocks for consistent cache use with any host block size
+    parameterManager.setMaxSubBlockSize(internalBlockSize);
+
+    // Run the DSP natively in the precision the host processes in
+    engines.setDoublePrecision(isUsingDoublePrecision());
+
     auto numChannels = static_cast<size_t>(getTotalNumOutputChannels());
     // Prepare all DSP objects and buffers here
-    compressor.prepare(numChannels, static_cast<float>(sampleRate));
+    engines.visit([&](auto& dsp) {
+        dsp.compressor.prepare(numChannels, static_cast<float>(sampleRate));
+        dsp.channelView.prepare(static_cast<int>(numChannels));
+    });
+
+    // Prepare framework parameter smoothing (FloatParams with a smoothing time in Params.h)
+    parameterManager.prepare(sampleRate);
 
     // Initialize DSP with parameter defaults (defined in Params.h) (skip smoothing for instant
     // setup)
@@ -81,14 +98,26 @@ void CompressorAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBl
 
 void CompressorAudioProcessor::releaseResources() {
     // Release DSP resources here
-    compressor.reset();
+    engines.visit([](auto& dsp) { dsp.compressor.reset(); });
 
     // Clear visualizer states
     visualizerManager.clearStates();
 }
 
-void CompressorAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
-                                            juce::MidiBuffer& midiMessages) {
+void CompressorAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    process(buffer, midiMessages);
+}
+
+void CompressorAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages) {
+    process(buffer, midiMessages);
+}
+
+bool CompressorAudioProcessor::supportsDoublePrecisionProcessing() const {
+    return true;
+}
+
+template <typename SampleType>
+void CompressorAudioProcessor::process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages) {
     // Get audio buffer info
     const int numInputChannels = getTotalNumInputChannels();
     const int numOutputChannels = getTotalNumOutputChannels();
@@ -100,29 +129,34 @@ void CompressorAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
         return;
     }
 
-    // Update all parameters from FIFO (GUI thread → Audio thread)
-    parameterManager.update();
-
     // Update all visualizers (Audio thread → Visualizer states)
     visualizerManager.update();
 
     // Handle denormals
     juce::ScopedNoDenormals noDenormals;
 
-    // Note: Jonssonic DSP expects numInputChannels == numOutputChannels
-    // So we map the input channels to output channels accordingly
-    jnsc::utils::mapChannels<float>(buffer.getArrayOfReadPointers(),
-                                    buffer.getArrayOfWritePointers(),
-                                    numInputChannels,
-                                    numOutputChannels,
-                                    numSamples);
+    // Turn learned MIDI CCs into sample-accurate parameter events
+    parameterManager.processMidi(midiMessages);
+
+    // Process in sub-blocks split at timestamped parameter events (applies pending GUI/host changes first)
+    parameterManager.processSubBlocks(numSamples, [&](int startSample, int numSubSamples) {
+        // View into the host buffer for this sub-block (no copy, no allocation)
+        juce::AudioBuffer<SampleType> block(
+            buffer.getArrayOfWritePointers(), buffer.getNumChannels(), startSample, numSubSamples);
 
-    // Process your DSP here using the mapped buffer
-    compressor.processBlock(
-        buffer.getArrayOfReadPointers(),  // Main input
-        buffer.getArrayOfReadPointers(),  // Detector input (sidechain) - using main input for now
-        buffer.getArrayOfWritePointers(), // Output
-        static_cast<size_t>(numSamples));
+        auto& dsp = engines.get<SampleType>(); // DSP of the host's precision
+
+        // Note: Jonssonic DSP expects numInputChannels == numOutputChannels
+        // So we map the input channels to output channels without copying (aliased channels are copied on write)
+        dsp.channelView.map(block.getArrayOfWritePointers(), numInputChannels, numOutputChannels, numSubSamples);
+
+        // Process your DSP here using the mapped channels
+        dsp.compressor.processBlock(
+            dsp.channelView.getReadPointers(),  // Main input
+            dsp.channelView.getReadPointers(),  // Detector input (sidechain) - using main input for now
+            dsp.channelView.getWritePointers(), // Output
+            static_cast<size_t>(numSubSamples));
+    });
 }
 
 void CompressorAudioProcessor::getStateInformation(juce::MemoryBlock& destData) {
@@ -153,14 +187,16 @@ double CompressorAudioProcessor::getTailLengthSeconds() const {
     return 0.0;
 }
 int CompressorAudioProcessor::getNumPrograms() {
-    return 1;
+    return juce::jmax(1, presetLibrary.size()); // Hosts expect at least one program
 }
 int CompressorAudioProcessor::getCurrentProgram() {
-    return 0;
+    return juce::jmax(0, presetLibrary.getCurrentIndex());
+}
+void CompressorAudioProcessor::setCurrentProgram(int index) {
+    presetLibrary.loadPreset(index, parameterManager);
 }
-void CompressorAudioProcessor::setCurrentProgram(int) {}
-const juce::String CompressorAudioProcessor::getProgramName(int) {
-    return {};
+const juce::String CompressorAudioProcessor::getProgramName(int index) {
+    return presetLibrary.getName(index);
 }
 void CompressorAudioProcessor::changeProgramName(int, const juce::String&) {}
 bool CompressorAudioProcessor::hasEditor() const {
@@ -5,7 +5,10 @@
 #include <MinimalJuceHeader.h>
 #include <jonssonic/effects/compressor.h>
 #include <parameters/ParameterManager.h>
+#include <presets/PresetLibrary.h>
+#include <utils/ChannelView.h>
 #include <visualizers/VisualizerManager.h>
+#include <utils/DualPrecision.h>
 
 class CompressorAudioProcessor : public juce::AudioProcessor {
   public:
@@ -15,6 +18,8 @@ class CompressorAudioProcessor : public juce::AudioProcessor {
 
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
     void releaseResources() override;
 
     void getStateInformation(juce::MemoryBlock& destData) override;
@@ -44,16 +49,31 @@ class CompressorAudioProcessor : public juce::AudioProcessor {
     }
 
   private:
+    // Process a block in the host's precision (float or double)
+    template <typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
+
+    // Fixed internal block size (the DSP never sees longer blocks, whatever the host sends)
+    static constexpr int internalBlockSize = 64;
+
     // Bus Properties
     static constexpr int mainInputBus = 0;
     static constexpr int sidechainBus = 1;
 
-    // DSP objects and buffers
-    jnsc::effects::Compressor<float> compressor; // Compressor DSP object
+    // DSP objects of one sample precision (only the precision the host uses is prepared)
+    template <typename SampleType>
+    struct Engine {
+        jnsc::effects::Compressor<SampleType> compressor;          // Compressor DSP object
+        jnsc::juce_interface::ChannelView<SampleType> channelView; // Maps inputs to outputs without copying
+    };
+    jnsc::juce_interface::DualPrecision<Engine> engines; // Float and double DSP
 
     // Parameter manager
     jnsc::juce_interface::ParameterManager<CompressorParams::ID> parameterManager;
 
+    // Preset library (host programs)
+    jnsc::juce_interface::PresetLibrary presetLibrary;
+
     // Visualizer manager
     jnsc::juce_interface::VisualizerManager<CompressorVisualizers::ID> visualizerManager;
 
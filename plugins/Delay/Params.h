@@ -23,18 +23,18 @@ struct DelayParams {
     };
 
     // Create parameter definitions
-    inline jnsc::juce_interface::ParameterSet<ID> createParams() {
+    static constexpr jnsc::juce_interface::ParameterSet<ID> createParams() {
         using namespace jnsc::juce_interface;
 
         ParameterSet<ID> params;
         // clang-format off
-    // Float parameter        ↓ id              ↓ name          ↓ min   ↓ max     ↓ def     ↓ unit  ↓ skew
+    // Float parameter        ↓ id              ↓ name          ↓ min   ↓ max     ↓ def     ↓ unit  ↓ skew  ↓ smoothing ms
     params.add(FloatParam<ID>{ID::DelayTimeMs,  "Time",         50.0f,   2000.0f,  500.0f,   "ms",   1.0f});
     params.add(FloatParam<ID>{ID::Feedback,     "Feedback",     0.0f,   100.0f,   0.0f,     "%",    1.0f});
     params.add(FloatParam<ID>{ID::PingPong,     "Spread",       0.0f,   100.0f,   0.0f,     "%",    1.0f});
     params.add(FloatParam<ID>{ID::Damping,      "Damping",      0.0f,   100.0f,   0.0f,     "%",    1.0f});
     params.add(FloatParam<ID>{ID::ModDepth,     "Modulation",   0.0f,   100.0f,   0.0f,     "%",    1.0f});
-    params.add(FloatParam<ID>{ID::Mix,          "Mix",          0.0f,   100.0f,   50.0f,    "%",    1.0f});
+    params.add(FloatParam<ID>{ID::Mix,          "Mix",          0.0f,   100.0f,   50.0f,    "%",    1.0f,   20.0f});
     return params;
         // clang-format on
     }
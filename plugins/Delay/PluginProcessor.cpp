@@ -2,9 +2,11 @@
 #include "PluginEditor.h"
 #include <JuceHeader.h>
 #include <iostream>
-#include <jonssonic/utils/buffer_utils.h>
 
-DelayAudioProcessor::DelayAudioProcessor() : parameterManager(DelayParams().createParams(), *this) {
+// Parameter definitions, evaluated at compile time (no heap allocation)
+static constexpr auto parameters = DelayParams::createParams();
+
+DelayAudioProcessor::DelayAudioProcessor() : parameterManager(parameters, *this) {
     // ============================================================================
     // [DEBUG]: Prints all APVTS parameter IDs at startup
     // This helps verify that your parameters are registered correctly.
@@ -18,40 +20,57 @@ DelayAudioProcessor::DelayAudioProcessor() : parameterManager(DelayParams().crea
     }
     // ============================================================================
 
+    // Map the preset library; without one the plugin exposes a single default program
+    presetLibrary.open(jnsc::juce_interface::PresetLibrary::getDefaultFile(JucePlugin_Name));
+
     // Register callbacks for parameter changes
     using ID = DelayParams::ID;
 
-    parameterManager.on(ID::Mix, [this](float value, bool skipSmoothing) { dryWetMixer.setMix(value * 0.01f); });
+    parameterManager.on(ID::Mix, [this](float value, bool skipSmoothing) {
+        engines.visit([&](auto& dsp) { dsp.dryWetMixer.setMix(value * 0.01f); });
+    });
 
-    parameterManager.on(ID::DelayTimeMs,
-                        [this](float value, bool skipSmoothing) { delayEffect.setDelayMs(value, skipSmoothing); });
+    parameterManager.on(ID::DelayTimeMs, [this](float value, bool skipSmoothing) {
+        engines.visit([&](auto& dsp) { dsp.delayEffect.setDelayMs(value, skipSmoothing); });
+    });
 
     parameterManager.on(ID::Feedback, [this](float value, bool skipSmoothing) {
-        delayEffect.setFeedback(value * 0.01f, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.delayEffect.setFeedback(value * 0.01f, skipSmoothing); });
     });
 
     parameterManager.on(ID::Damping, [this](float value, bool skipSmoothing) {
-        delayEffect.setDamping(value * 0.01f, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.delayEffect.setDamping(value * 0.01f, skipSmoothing); });
     });
 
     parameterManager.on(ID::PingPong, [this](float value, bool skipSmoothing) {
-        delayEffect.setPingPong(value * 0.01f, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.delayEffect.setPingPong(value * 0.01f, skipSmoothing); });
     });
 
     parameterManager.on(ID::ModDepth, [this](float value, bool skipSmoothing) {
-        delayEffect.setModDepth(value * 0.01f, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.delayEffect.setModDepth(value * 0.01f, skipSmoothing); });
     });
 }
 
 DelayAudioProcessor::~DelayAudioProcessor() {}
 
 void DelayAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
+    // Process in fixed internal blocks for consistent cache use with any host block size
+    parameterManager.setMaxSubBlockSize(internalBlockSize);
+
+    // Run the DSP natively in the precision the host processes in
+    engines.setDoublePrecision(isUsingDoublePrecision());
+
     auto numChannels = static_cast<size_t>(getTotalNumOutputChannels());
 
     // Prepare all DSP objects and buffers here
-    dryWetMixer.prepare(numChannels, static_cast<float>(sampleRate));
-    fxBuffer.setSize(static_cast<int>(numChannels), samplesPerBlock);
-    delayEffect.prepare(numChannels, static_cast<size_t>(samplesPerBlock), static_cast<float>(sampleRate));
+    engines.visit([&](auto& dsp) {
+        dsp.dryWetMixer.prepare(numChannels, static_cast<float>(sampleRate));
+        dsp.effectChain.prepare(static_cast<int>(numChannels), scratchArena);
+        dsp.delayEffect.prepare(numChannels, static_cast<size_t>(internalBlockSize), static_cast<float>(sampleRate));
+    });
+
+    // Prepare framework parameter smoothing (FloatParams with a smoothing time in Params.h)
+    parameterManager.prepare(sampleRate);
 
     // Initialize DSP with parameter defaults (defined in Params.h) (skip smoothing for instant setup)
     parameterManager.syncAll(true);
@@ -59,12 +78,27 @@ void DelayAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 
 void DelayAudioProcessor::releaseResources() {
     // Release DSP resources here
-    dryWetMixer.reset();
-    fxBuffer.setSize(0, 0);
-    delayEffect.reset();
+    engines.visit([](auto& dsp) {
+        dsp.dryWetMixer.reset();
+        dsp.delayEffect.reset();
+    });
+    scratchArena.release();
 }
 
 void DelayAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    process(buffer, midiMessages);
+}
+
+void DelayAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages) {
+    process(buffer, midiMessages);
+}
+
+bool DelayAudioProcessor::supportsDoublePrecisionProcessing() const {
+    return true;
+}
+
+template <typename SampleType>
+void DelayAudioProcessor::process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages) {
     // Get audio buffer info
     const int numInputChannels = getTotalNumInputChannels();
     const int numOutputChannels = getTotalNumOutputChannels();
@@ -73,28 +107,23 @@ void DelayAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
     // Early return if no audio to process
     if (numInputChannels == 0 || numOutputChannels == 0 || numSamples == 0)
         return;
-    // Update all parameters from FIFO (GUI thread → Audio thread)
-    parameterManager.update();
 
     // Handle denormals
     juce::ScopedNoDenormals noDenormals;
 
-    // Note: Jonssonic DSP expects numInputChannels == numOutputChannels
-    // So we map the input channels to output channels accordingly
-    jnsc::utils::mapChannels<float>(buffer.getArrayOfReadPointers(),
-                                    fxBuffer.getArrayOfWritePointers(),
-                                    numInputChannels,
-                                    numOutputChannels,
-                                    numSamples);
+    // Turn learned MIDI CCs into sample-accurate parameter events
+    parameterManager.processMidi(midiMessages);
+
+    // Process in sub-blocks split at timestamped parameter events (applies pending GUI/host changes first)
+    parameterManager.processSubBlocks(numSamples, [&](int startSample, int numSubSamples) {
+        // View into the host buffer for this sub-block (no copy, no allocation)
+        juce::AudioBuffer<SampleType> block(
+            buffer.getArrayOfWritePointers(), buffer.getNumChannels(), startSample, numSubSamples);
 
-    // DSP processing here (this template includes only a dry/wet mixer as an example)
-    delayEffect.processBlock(fxBuffer.getArrayOfWritePointers(),
-                             fxBuffer.getArrayOfWritePointers(),
-                             static_cast<size_t>(numSamples));
-    dryWetMixer.processBlock(buffer.getArrayOfReadPointers(),   // dry input
-                             fxBuffer.getArrayOfReadPointers(), // wet input
-                             buffer.getArrayOfWritePointers(),  // output
-                             static_cast<size_t>(numSamples));  // number of samples
+        // Map inputs to outputs and run the chain in place (effect and mix per cache-sized chunk)
+        engines.get<SampleType>().effectChain.process(
+            block.getArrayOfWritePointers(), numInputChannels, numOutputChannels, numSubSamples);
+    });
 }
 
 void DelayAudioProcessor::getStateInformation(juce::MemoryBlock& destData) {
@@ -125,14 +154,16 @@ double DelayAudioProcessor::getTailLengthSeconds() const {
     return 0.0;
 }
 int DelayAudioProcessor::getNumPrograms() {
-    return 1;
+    return juce::jmax(1, presetLibrary.size()); // Hosts expect at least one program
 }
 int DelayAudioProcessor::getCurrentProgram() {
-    return 0;
+    return juce::jmax(0, presetLibrary.getCurrentIndex());
+}
+void DelayAudioProcessor::setCurrentProgram(int index) {
+    presetLibrary.loadPreset(index, parameterManager);
 }
-void DelayAudioProcessor::setCurrentProgram(int) {}
-const juce::String DelayAudioProcessor::getProgramName(int) {
-    return {};
+const juce::String DelayAudioProcessor::getProgramName(int index) {
+    return presetLibrary.getName(index);
 }
 void DelayAudioProcessor::changeProgramName(int, const juce::String&) {}
 bool DelayAudioProcessor::hasEditor() const {
@@ -2,11 +2,23 @@
 #include "PluginEditor.h"
 #include <JuceHeader.h>
 #include <iostream>
-#include <jonssonic/utils/buffer_utils.h>
 #include <jonssonic/utils/math_utils.h>
 
-DistortionAudioProcessor::DistortionAudioProcessor()
-    : parameterManager(DistortionParams().createParams(), *this) {
+// Parameter definitions, evaluated at compile time (no heap allocation)
+static constexpr auto parameters = DistortionParams::createParams();
+
+template <typename Distortion, typename GetValue>
+void DistortionAudioProcessor::applySettings(Distortion& distortion, GetValue&& getValue) {
+    using ID = DistortionParams::ID;
+    distortion.setDriveDb(getValue(ID::Drive), true);
+    distortion.setAsymmetry(getValue(ID::Asymmetry) * 0.01f, true);
+    distortion.setShape(getValue(ID::Shape) * 0.01f, true);
+    distortion.setToneFrequency(getValue(ID::Tone));
+    distortion.setMix(getValue(ID::Mix) * 0.01f, true);
+    distortion.setOutputGainDb(getValue(ID::Output), true);
+}
+
+DistortionAudioProcessor::DistortionAudioProcessor() : parameterManager(parameters, *this) {
     // ============================================================================
     // [DEBUG]: Prints all APVTS parameter IDs at startup
     // This helps verify that your parameters are registered correctly.
@@ -20,61 +32,116 @@ DistortionAudioProcessor::DistortionAudioProcessor()
     }
     // ============================================================================
 
+    // Map the preset library; without one the plugin exposes a single default program
+    presetLibrary.open(jnsc::juce_interface::PresetLibrary::getDefaultFile(JucePlugin_Name));
+
     // Register callbacks for parameter changes
     using ID = DistortionParams::ID;
 
     parameterManager.on(ID::Drive, [this](float value, bool skipSmoothing) {
         DBG("[DEBUG] Drive changed: " + juce::String(value) +
             ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        distortion.setDriveDb(value, skipSmoothing);
+        applyToDistortion([&](auto& d) { d.setDriveDb(value, skipSmoothing); });
     });
 
     parameterManager.on(ID::Asymmetry, [this](float value, bool skipSmoothing) {
         DBG("[DEBUG] Asymmetry changed: " + juce::String(value) +
             ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        distortion.setAsymmetry(value * 0.01f, skipSmoothing);
-    });
-
-    parameterManager.on(ID::Shape, [this](float value, bool skipSmoothing) {
-        DBG("[DEBUG] Shape changed: " + juce::String(value) +
-            ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        distortion.setShape(value * 0.01f, skipSmoothing);
+        applyToDistortion([&](auto& d) { d.setAsymmetry(value * 0.01f, skipSmoothing); });
     });
 
-    parameterManager.on(ID::Tone, [this](float value, bool skipSmoothing) {
-        DBG("[DEBUG] Tone changed: " + juce::String(value) +
-            ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        distortion.setToneFrequency(value);
+    parameterManager.on(ID::Tone, [this](float value, bool /*skipSmoothing*/) {
+        applyToDistortion([&](auto& d) { d.setToneFrequency(value); });
     });
 
     parameterManager.on(ID::Mix, [this](float value, bool skipSmoothing) {
         DBG("[DEBUG] Mix changed: " + juce::String(value) +
             ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        distortion.setMix(value * 0.01f, skipSmoothing);
+        applyToDistortion([&](auto& d) { d.setMix(value * 0.01f, skipSmoothing); });
     });
 
     parameterManager.on(ID::Output, [this](float value, bool skipSmoothing) {
         DBG("[DEBUG] Output changed: " + juce::String(value) +
             ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        distortion.setOutputGainDb(value, skipSmoothing);
+        applyToDistortion([&](auto& d) { d.setOutputGainDb(value, skipSmoothing); });
+    });
+
+    // Expensive rebuilds run at most once per sub-block, however often their inputs change
+    derivedValues.add({ID::Shape}, [this](bool skipSmoothing) {
+        // Rebuilds the waveshaper
+        const float value = parameterManager.getFrame()[ID::Shape];
+        DBG("[DEBUG] Shape changed: " + juce::String(value) +
+            ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
+        applyToDistortion([&](auto& d) { d.setShape(value * 0.01f, skipSmoothing); });
     });
 
-    parameterManager.on(ID::Oversampling, [this](float enabled, bool /*skipSmoothing*/) {
-        bool isEnabled = (enabled >= 0.5f);
+    derivedValues.add({ID::Oversampling}, [this](bool /*skipSmoothing*/) {
+        bool isEnabled = parameterManager.getFrame().getBool(ID::Oversampling);
         DBG("[DEBUG] Oversampling changed: " + juce::String(isEnabled ? "true" : "false"));
-        distortion.setOversamplingEnabled(isEnabled);
-        setLatencySamples(distortion.getLatencySamples());
+        // Reallocates, so a new instance is built off the audio thread and crossfaded in
+        if (oversamplingEnabled.exchange(isEnabled) != isEnabled)
+            engines.visit([](auto& dsp) { dsp.distortion.requestRebuild(); });
     });
+
+    parameterManager.setDerivedValues(&derivedValues);
+
+    // Builds a fully prepared distortion on the rebuild thread, starting from the current host values
+    auto setUpDistortion = [this](auto& distortion) {
+        using Distortion = std::decay_t<decltype(distortion.get())>;
+        distortion.setFactory([this] {
+            auto fresh = std::make_unique<Distortion>();
+            fresh->prepare(preparedNumChannels, preparedBlockSize, preparedSampleRate);
+            fresh->setOversamplingEnabled(oversamplingEnabled.load());
+            applySettings(*fresh, [this](ID id) { return parameterManager.getNativeValue(id); });
+            return fresh;
+        });
+
+        // Changes made while the instance was being built only reached the outgoing one
+        distortion.setOnPickup([this](auto& d) {
+            applySettings(d, [this](ID id) { return parameterManager.getFrame()[id]; });
+        });
+
+        // Report the latency of the instance taking over (setLatencySamples() is not real-time safe)
+        distortion.setOnActivate([this](auto& d) {
+            latencySamples.store(d.getLatencySamples());
+            triggerAsyncUpdate();
+        });
+    };
+    setUpDistortion(engines.get<float>().distortion);
+    setUpDistortion(engines.get<double>().distortion);
 }
 
 DistortionAudioProcessor::~DistortionAudioProcessor() {}
 
+void DistortionAudioProcessor::handleAsyncUpdate() {
+    setLatencySamples(latencySamples.load());
+}
+
 void DistortionAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
-    auto numChannels = static_cast<size_t>(getTotalNumOutputChannels());
-    // Prepare all DSP objects and buffers here
-    distortion.prepare(numChannels,
-                       static_cast<size_t>(samplesPerBlock),
-                       static_cast<float>(sampleRate));
+    // Process in fixed internal blocks for consistent cache use with any host block size
+    parameterManager.setMaxSubBlockSize(internalBlockSize);
+
+    // Mono input into several outputs: the DSP runs on one channel and is copied to the others
+    channelFanOut.prepare(getTotalNumInputChannels(), getTotalNumOutputChannels());
+    auto numChannels = static_cast<size_t>(channelFanOut.getNumProcessChannels());
+    // Prepare all DSP objects and buffers here (the first distortion is built here, later ones off-thread)
+    // Stop the rebuild threads before changing the configuration they read (frees the unused precision too)
+    engines.get<float>().distortion.release();
+    engines.get<double>().distortion.release();
+    preparedNumChannels = numChannels;
+    preparedBlockSize = static_cast<size_t>(internalBlockSize);
+    preparedSampleRate = static_cast<float>(sampleRate);
+    oversamplingEnabled.store(parameterManager.getNativeValue(DistortionParams::ID::Oversampling) >= 0.5f);
+
+    // Run the DSP natively in the precision the host processes in
+    engines.setDoublePrecision(isUsingDoublePrecision());
+    engines.visit([&](auto& dsp) {
+        dsp.distortion.prepare(sampleRate, static_cast<int>(numChannels), internalBlockSize);
+    });
+    setLatencySamples(latencySamples.load()); // Known before playback starts
+
+    // Prepare framework parameter smoothing (FloatParams with a smoothing time in Params.h)
+    parameterManager.prepare(sampleRate);
 
     // Initialize DSP with parameter defaults (defined in Params.h) (skip smoothing for instant
     // setup)
@@ -83,11 +150,23 @@ void DistortionAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBl
 
 void DistortionAudioProcessor::releaseResources() {
     // Release DSP resources here
-    distortion.reset();
+    applyToDistortion([](auto& d) { d.reset(); });
+}
+
+void DistortionAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    process(buffer, midiMessages);
 }
 
-void DistortionAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
-                                            juce::MidiBuffer& midiMessages) {
+void DistortionAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages) {
+    process(buffer, midiMessages);
+}
+
+bool DistortionAudioProcessor::supportsDoublePrecisionProcessing() const {
+    return true;
+}
+
+template <typename SampleType>
+void DistortionAudioProcessor::process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages) {
     // Get audio buffer info
     const int numInputChannels = getTotalNumInputChannels();
     const int numOutputChannels = getTotalNumOutputChannels();
@@ -97,24 +176,30 @@ void DistortionAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     if (numInputChannels == 0 || numOutputChannels == 0 || numSamples == 0)
         return;
 
-    // Update all parameters from FIFO (GUI thread → Audio thread)
-    parameterManager.update();
-
     // Handle denormals
     juce::ScopedNoDenormals noDenormals;
 
-    // Note: Jonssonic DSP expects numInputChannels == numOutputChannels
-    // So we map the input channels to output channels accordingly
-    jnsc::utils::mapChannels<float>(buffer.getArrayOfReadPointers(),
-                                    buffer.getArrayOfWritePointers(),
-                                    static_cast<size_t>(numInputChannels),
-                                    static_cast<size_t>(numOutputChannels),
-                                    static_cast<size_t>(numSamples));
+    // Turn learned MIDI CCs into sample-accurate parameter events
+    parameterManager.processMidi(midiMessages);
+
+    // Process in sub-blocks split at timestamped parameter events (applies pending GUI/host changes first)
+    parameterManager.processSubBlocks(numSamples, [&](int startSample, int numSubSamples) {
+        // View into the host buffer for this sub-block (no copy, no allocation)
+        juce::AudioBuffer<SampleType> block(
+            buffer.getArrayOfWritePointers(), buffer.getNumChannels(), startSample, numSubSamples);
 
-    // Process distortion effect (dry/wet mixing and output gain applied inside)
-    distortion.processBlock(buffer.getArrayOfReadPointers(),
-                            buffer.getArrayOfWritePointers(),
-                            static_cast<size_t>(numSamples));
+        // Note: Jonssonic DSP expects numInputChannels == numOutputChannels
+        // The fan-out maps the input channels to the output channels without copying
+        // Process distortion effect (dry/wet mixing and output gain applied inside),
+        // crossfading to a rebuilt instance if one is ready; mono input is processed once
+        auto& distortion = engines.get<SampleType>().distortion;
+        channelFanOut.process(
+            block.getArrayOfWritePointers(), numSubSamples, [&](SampleType* const* ch, int numCh, int n) {
+                distortion.process(ch, numCh, n, [](auto& d, SampleType* const* channels, size_t length) {
+                    d.processBlock(channels, channels, length);
+                });
+            });
+    });
 }
 
 void DistortionAudioProcessor::getStateInformation(juce::MemoryBlock& destData) {
@@ -145,14 +230,16 @@ double DistortionAudioProcessor::getTailLengthSeconds() const {
     return 0.0;
 }
 int DistortionAudioProcessor::getNumPrograms() {
-    return 1;
+    return juce::jmax(1, presetLibrary.size()); // Hosts expect at least one program
 }
 int DistortionAudioProcessor::getCurrentProgram() {
-    return 0;
+    return juce::jmax(0, presetLibrary.getCurrentIndex());
+}
+void DistortionAudioProcessor::setCurrentProgram(int index) {
+    presetLibrary.loadPreset(index, parameterManager);
 }
-void DistortionAudioProcessor::setCurrentProgram(int) {}
-const juce::String DistortionAudioProcessor::getProgramName(int) {
-    return {};
+const juce::String DistortionAudioProcessor::getProgramName(int index) {
+    return presetLibrary.getName(index);
 }
 void DistortionAudioProcessor::changeProgramName(int, const juce::String&) {}
 bool DistortionAudioProcessor::hasEditor() const {
@@ -3,14 +3,20 @@
 #include <JuceHeader.h>
 #include <jonssonic/effects/distortion.h>
 #include <parameters/ParameterManager.h>
+#include <parameters/ProcessorSwap.h>
+#include <presets/PresetLibrary.h>
+#include <utils/ChannelFanOut.h>
+#include <utils/DualPrecision.h>
 
-class DistortionAudioProcessor : public juce::AudioProcessor {
+class DistortionAudioProcessor : public juce::AudioProcessor, private juce::AsyncUpdater {
   public:
     DistortionAudioProcessor();
     ~DistortionAudioProcessor() override;
 
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
     void releaseResources() override;
 
     void getStateInformation(juce::MemoryBlock& destData) override;
@@ -34,12 +40,56 @@ class DistortionAudioProcessor : public juce::AudioProcessor {
     // Parameter access for editor
     juce::AudioProcessorValueTreeState& getAPVTS() { return parameterManager.getAPVTS(); }
 
+    // Parameter manager access for offline tools (automation capture and replay)
+    jnsc::juce_interface::ParameterManager<DistortionParams::ID>& getParameterManager() { return parameterManager; }
+
   private:
-    // DSP objects and buffers
-    jnsc::effects::Distortion<float> distortion; // Distortion effect processor
+    // Process a block in the host's precision (float or double)
+    template <typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
+
+    // Fixed internal block size (the DSP never sees longer blocks, whatever the host sends)
+    static constexpr int internalBlockSize = 64;
 
     // Parameter manager
     jnsc::juce_interface::ParameterManager<DistortionParams::ID> parameterManager;
 
+    // Reports the latency of a newly active distortion to the host (message thread)
+    void handleAsyncUpdate() override;
+
+    // Configuration read by the distortion factory (rebuild thread)
+    size_t preparedNumChannels = 2;
+    size_t preparedBlockSize = 512;
+    float preparedSampleRate = 44100.0f;
+    std::atomic<bool> oversamplingEnabled{false};
+
+    // Latency of the active distortion, set on the audio thread and reported from the message thread
+    std::atomic<int> latencySamples{0};
+
+    // DSP objects of one sample precision (only the precision the host uses is prepared)
+    template <typename SampleType>
+    struct Engine {
+        // Distortion effect processor
+        jnsc::juce_interface::ProcessorSwap<jnsc::effects::Distortion<SampleType>> distortion;
+    };
+    jnsc::juce_interface::DualPrecision<Engine> engines; // Float and double DSP
+    jnsc::juce_interface::ChannelFanOut channelFanOut;  // Processes mono input once
+
+    // Push the current settings to a distortion instance, reading native values through getValue(ID)
+    template <typename Distortion, typename GetValue>
+    static void applySettings(Distortion& distortion, GetValue&& getValue);
+
+    // Apply a setting to the distortion of the active precision (both instances while crossfading)
+    template <typename Fn>
+    void applyToDistortion(Fn&& fn) {
+        engines.visit([&](auto& dsp) { dsp.distortion.apply(fn); });
+    }
+
+    // Derived values rebuilt once per sub-block (waveshaper, oversampling)
+    jnsc::juce_interface::DerivedValueGraph<> derivedValues;
+
+    // Preset library (host programs)
+    jnsc::juce_interface::PresetLibrary presetLibrary;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DistortionAudioProcessor)
 };
\ No newline at end of file
@@ -2,9 +2,11 @@
 #include "PluginEditor.h"
 #include <JuceHeader.h>
 #include <iostream>
-#include <jonssonic/utils/buffer_utils.h>
 
-EQAudioProcessor::EQAudioProcessor() : parameterManager(EQParams().createParams(), *this) {
+// Parameter definitions, evaluated at compile time (no heap allocation)
+static constexpr auto parameters = EQParams::createParams();
+
+EQAudioProcessor::EQAudioProcessor() : parameterManager(parameters, *this) {
     // ============================================================================
     // [DEBUG]: Prints all APVTS parameter IDs at startup
     // This helps verify that your parameters are registered correctly.
@@ -18,61 +20,77 @@ EQAudioProcessor::EQAudioProcessor() : parameterManager(EQParams().createParams(
     }
     // ============================================================================
 
-    // Register callbacks for parameter changes
-    using ID = EQParams::ID;
-
-    parameterManager.on(ID::LowCutFreq, [this](float value, bool skipSmoothing) {
-        // Update low cut filter frequency
-        equalizer.setLowCutFreq(value, skipSmoothing);
-    });
+    // Map the preset library; without one the plugin exposes a single default program
+    presetLibrary.open(jnsc::juce_interface::PresetLibrary::getDefaultFile(JucePlugin_Name));
 
-    parameterManager.on(ID::LowMidGain, [this](float value, bool skipSmoothing) {
-        // Update low mid gain
-        equalizer.setLowMidGainDb(value, skipSmoothing);
-    });
+    // No callbacks: parameter values are pulled once per sub-block (see applyParameters)
+}
 
-    parameterManager.on(ID::HighMidGain, [this](float value, bool skipSmoothing) {
-        // Update high mid gain
-        equalizer.setHighMidGainDb(value, skipSmoothing);
-    });
+EQAudioProcessor::~EQAudioProcessor() {}
 
-    parameterManager.on(ID::HighShelfGain, [this](float value, bool skipSmoothing) {
-        // Update high shelf gain
-        equalizer.setHighShelfGainDb(value, skipSmoothing);
-    });
+template <typename SampleType>
+void EQAudioProcessor::applyParameters(const jnsc::juce_interface::ParamFrame<EQParams::ID>& frame) {
+    using ID = EQParams::ID;
+    if (!frame.anyChanged())
+        return;
 
-    parameterManager.on(ID::LowMidFreq, [this](float value, bool skipSmoothing) {
-        // Update low mid frequency
-        equalizer.setLowMidFreq(value, skipSmoothing);
-    });
+    auto& equalizer = engines.get<SampleType>().equalizer;
 
-    parameterManager.on(ID::HighMidFreq, [this](float value, bool skipSmoothing) {
-        // Update high mid frequency
-        equalizer.setHighMidFreq(value, skipSmoothing);
-    });
+    if (frame.hasChanged(ID::LowCutFreq))
+        equalizer.setLowCutFreq(frame[ID::LowCutFreq], frame.shouldSkipSmoothing(ID::LowCutFreq));
+    if (frame.hasChanged(ID::LowMidGain))
+        equalizer.setLowMidGainDb(frame[ID::LowMidGain], frame.shouldSkipSmoothing(ID::LowMidGain));
+    if (frame.hasChanged(ID::HighMidGain))
+        equalizer.setHighMidGainDb(frame[ID::HighMidGain], frame.shouldSkipSmoothing(ID::HighMidGain));
+    if (frame.hasChanged(ID::HighShelfGain))
+        equalizer.setHighShelfGainDb(frame[ID::HighShelfGain], frame.shouldSkipSmoothing(ID::HighShelfGain));
+    if (frame.hasChanged(ID::LowMidFreq))
+        equalizer.setLowMidFreq(frame[ID::LowMidFreq], frame.shouldSkipSmoothing(ID::LowMidFreq));
+    if (frame.hasChanged(ID::HighMidFreq))
+        equalizer.setHighMidFreq(frame[ID::HighMidFreq], frame.shouldSkipSmoothing(ID::HighMidFreq));
 }
 
-EQAudioProcessor::~EQAudioProcessor() {}
-
 void EQAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
-    auto numChannels = static_cast<size_t>(getTotalNumOutputChannels());
+    // Process in fixed internal blocks for consistent cache use with any host block size
+    parameterManager.setMaxSubBlockSize(internalBlockSize);
+
+    // Run the DSP natively in the precision the host processes in
+    engines.setDoublePrecision(isUsingDoublePrecision());
+
+    // Mono input into several outputs: the DSP runs on one channel and is copied to the others
+    channelFanOut.prepare(getTotalNumInputChannels(), getTotalNumOutputChannels());
+    auto numChannels = static_cast<size_t>(channelFanOut.getNumProcessChannels());
     // Prepare all DSP objects and buffers here
-    equalizer.prepare(numChannels,
-                      static_cast<size_t>(samplesPerBlock),
-                      static_cast<float>(sampleRate));
+    engines.visit([&](auto& dsp) {
+        dsp.equalizer.prepare(numChannels, static_cast<size_t>(internalBlockSize), static_cast<float>(sampleRate));
+    });
+
+    // Prepare framework parameter smoothing (FloatParams with a smoothing time in Params.h)
+    parameterManager.prepare(sampleRate);
 
-    // Initialize DSP with parameter defaults (defined in Params.h) (skip smoothing for instant
-    // setup)
+    // Flag all parameters for the first frame (skip smoothing for instant setup)
     parameterManager.syncAll(true);
 }
 
 void EQAudioProcessor::releaseResources() {
     // Release DSP resources here
-    equalizer.reset();
+    engines.visit([](auto& dsp) { dsp.equalizer.reset(); });
+}
+
+void EQAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    process(buffer, midiMessages);
+}
+
+void EQAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages) {
+    process(buffer, midiMessages);
 }
 
-void EQAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
-                                    juce::MidiBuffer& midiMessages) {
+bool EQAudioProcessor::supportsDoublePrecisionProcessing() const {
+    return true;
+}
+
+template <typename SampleType>
+void EQAudioProcessor::process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages) {
     // Get audio buffer info
     const int numInputChannels = getTotalNumInputChannels();
     const int numOutputChannels = getTotalNumOutputChannels();
@@ -82,24 +100,30 @@ void EQAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     if (numInputChannels == 0 || numOutputChannels == 0 || numSamples == 0)
         return;
 
-    // Update all parameters from FIFO (GUI thread → Audio thread)
-    parameterManager.update();
-
     // Handle denormals
     juce::ScopedNoDenormals noDenormals;
 
-    // Note: Jonssonic DSP expects numInputChannels == numOutputChannels
-    // So we map the input channels to output channels accordingly
-    jnsc::utils::mapChannels<float>(buffer.getArrayOfReadPointers(),
-                                    buffer.getArrayOfWritePointers(),
-                                    numInputChannels,
-                                    numOutputChannels,
-                                    numSamples);
-
-    // Process the EQ DSP here
-    equalizer.processBlock(buffer.getArrayOfWritePointers(),
-                           buffer.getArrayOfWritePointers(),
-                           static_cast<size_t>(numSamples));
+    // Turn learned MIDI CCs into sample-accurate parameter events
+    parameterManager.processMidi(midiMessages);
+
+    // Process in sub-blocks split at timestamped parameter events (applies pending GUI/host changes first)
+    parameterManager.processSubBlocks(numSamples, [&](int startSample, int numSubSamples) {
+        // Pull the parameter values of this sub-block
+        applyParameters<SampleType>(parameterManager.getFrame());
+
+        // View into the host buffer for this sub-block (no copy, no allocation)
+        juce::AudioBuffer<SampleType> block(
+            buffer.getArrayOfWritePointers(), buffer.getNumChannels(), startSample, numSubSamples);
+
+        // Note: Jonssonic DSP expects numInputChannels == numOutputChannels
+        // The fan-out maps the input channels to the output channels without copying
+        // Process the EQ DSP here (once for mono input, then copied to the other outputs)
+        auto& equalizer = engines.get<SampleType>().equalizer;
+        channelFanOut.process(
+            block.getArrayOfWritePointers(), numSubSamples, [&](SampleType* const* channels, int, int n) {
+                equalizer.processBlock(channels, channels, static_cast<size_t>(n));
+            });
+    });
 }
 
 void EQAudioProcessor::getStateInformation(juce::MemoryBlock& destData) {
@@ -130,14 +154,16 @@ double EQAudioProcessor::getTailLengthSeconds() const {
     return 0.0;
 }
 int EQAudioProcessor::getNumPrograms() {
-    return 1;
+    return juce::jmax(1, presetLibrary.size()); // Hosts expect at least one program
 }
 int EQAudioProcessor::getCurrentProgram() {
-    return 0;
+    return juce::jmax(0, presetLibrary.getCurrentIndex());
+}
+void EQAudioProcessor::setCurrentProgram(int index) {
+    presetLibrary.loadPreset(index, parameterManager);
 }
-void EQAudioProcessor::setCurrentProgram(int) {}
-const juce::String EQAudioProcessor::getProgramName(int) {
-    return {};
+const juce::String EQAudioProcessor::getProgramName(int index) {
+    return presetLibrary.getName(index);
 }
 void EQAudioProcessor::changeProgramName(int, const juce::String&) {}
 bool EQAudioProcessor::hasEditor() const {
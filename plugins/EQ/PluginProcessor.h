@@ -3,6 +3,9 @@
 #include <MinimalJuceHeader.h>
 #include <jonssonic/effects/equalizer.h>
 #include <parameters/ParameterManager.h>
+#include <presets/PresetLibrary.h>
+#include <utils/ChannelFanOut.h>
+#include <utils/DualPrecision.h>
 
 class EQAudioProcessor : public juce::AudioProcessor {
   public:
@@ -11,6 +14,8 @@ class EQAudioProcessor : public juce::AudioProcessor {
 
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
     void releaseResources() override;
 
     void getStateInformation(juce::MemoryBlock& destData) override;
@@ -36,11 +41,30 @@ class EQAudioProcessor : public juce::AudioProcessor {
     juce::AudioProcessorValueTreeState& getAPVTS() { return parameterManager.getAPVTS(); }
 
   private:
-    // DSP objects and buffers
-    jnsc::effects::Equalizer<float> equalizer;
+    // Process a block in the host's precision (float or double)
+    template <typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
+
+    // Fixed internal block size (the DSP never sees longer blocks, whatever the host sends)
+    static constexpr int internalBlockSize = 64;
+
+    // Push changed parameter values to the DSP of one precision (audio thread, once per sub-block)
+    template <typename SampleType>
+    void applyParameters(const jnsc::juce_interface::ParamFrame<EQParams::ID>& frame);
+
+    // DSP objects of one sample precision (only the precision the host uses is prepared)
+    template <typename SampleType>
+    struct Engine {
+        jnsc::effects::Equalizer<SampleType> equalizer;
+    };
+    jnsc::juce_interface::DualPrecision<Engine> engines; // Float and double DSP
+    jnsc::juce_interface::ChannelFanOut channelFanOut;  // Processes mono input once
 
     // Parameter manager
     jnsc::juce_interface::ParameterManager<EQParams::ID> parameterManager;
 
+    // Preset library (host programs)
+    jnsc::juce_interface::PresetLibrary presetLibrary;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EQAudioProcessor)
 };
\ No newline at end of file
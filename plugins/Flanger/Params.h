@@ -14,7 +14,7 @@ struct FlangerParams {
     enum class ID { Rate, Depth, Spread, Delay, Feedback, Mix };
 
     // Create parameter definitions
-    inline jnsc::juce_interface::ParameterSet<ID> createParams() {
+    static constexpr jnsc::juce_interface::ParameterSet<ID> createParams() {
         using namespace jnsc::juce_interface;
         ParameterSet<ID> params;
         //                        ↓ id              ↓ name          ↓ min   ↓ max   ↓ def   ↓ unit ↓ skew
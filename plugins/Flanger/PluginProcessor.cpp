@@ -2,9 +2,11 @@
 #include "PluginEditor.h"
 #include <JuceHeader.h>
 #include <iostream>
-#include <jonssonic/utils/buffer_utils.h>
 
-FlangerAudioProcessor::FlangerAudioProcessor() : parameterManager(FlangerParams().createParams(), *this) {
+// Parameter definitions, evaluated at compile time (no heap allocation)
+static constexpr auto parameters = FlangerParams::createParams();
+
+FlangerAudioProcessor::FlangerAudioProcessor() : parameterManager(parameters, *this) {
     // Print all APVTS parameter IDs at startup
     auto& apvts = parameterManager.getAPVTS();
     DBG("[DEBUG] APVTS parameter IDs at startup:");
@@ -16,61 +18,91 @@ FlangerAudioProcessor::FlangerAudioProcessor() : parameterManager(FlangerParams(
 
     // ...existing code...
 
+    // Map the preset library; without one the plugin exposes a single default program
+    presetLibrary.open(jnsc::juce_interface::PresetLibrary::getDefaultFile(JucePlugin_Name));
+
     // Register callbacks for parameter changes
     using ID = FlangerParams::ID;
 
     parameterManager.on(ID::Rate, [this](float value, bool skipSmoothing) {
         DBG("[DSP] Rate changed: " + juce::String(value) + ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        flanger.setRate(value, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.flanger.setRate(value, skipSmoothing); });
     });
 
     parameterManager.on(ID::Depth, [this](float value, bool skipSmoothing) {
         DBG("[DSP] Depth changed: " + juce::String(value) + ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        flanger.setDepth(value * 0.01f, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.flanger.setDepth(value * 0.01f, skipSmoothing); });
     });
 
     parameterManager.on(ID::Spread, [this](float value, bool skipSmoothing) {
         DBG("[DSP] Spread changed: " + juce::String(value) + ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        flanger.setSpread(value * 0.01f, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.flanger.setSpread(value * 0.01f, skipSmoothing); });
     });
 
     parameterManager.on(ID::Delay, [this](float value, bool skipSmoothing) {
         DBG("[DSP] Delay changed: " + juce::String(value) + ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        flanger.setDelayMs(value, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.flanger.setDelayMs(value, skipSmoothing); });
     });
 
     parameterManager.on(ID::Feedback, [this](float value, bool skipSmoothing) {
         DBG("[DSP] Feedback changed: " + juce::String(value) +
             ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        flanger.setFeedback(value * 0.01f, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.flanger.setFeedback(value * 0.01f, skipSmoothing); });
     });
 
     parameterManager.on(ID::Mix, [this](float value, bool skipSmoothing) {
         DBG("[DSP] Mix changed: " + juce::String(value) + ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
-        dryWetMixer.setMix(value * 0.01f, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.dryWetMixer.setMix(value * 0.01f, skipSmoothing); });
     });
 }
 
 FlangerAudioProcessor::~FlangerAudioProcessor() {}
 
 void FlangerAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
+    // Process in fixed internal blocks for consistent cache use with any host block size
+    parameterManager.setMaxSubBlockSize(internalBlockSize);
+
+    // Run the DSP natively in the precision the host processes in
+    engines.setDoublePrecision(isUsingDoublePrecision());
+
     auto numChannels = static_cast<size_t>(getTotalNumOutputChannels());
-    flanger.prepare(numChannels, sampleRate);
-    fxBuffer.resize(numChannels, samplesPerBlock);
-    dryWetMixer.prepare(numChannels, sampleRate);
-    dryWetMixer.setControlSmoothingTime(jnsc::Time<float>::Milliseconds(50.0f));
+    engines.visit([&](auto& dsp) {
+        using SampleType = typename jnsc::juce_interface::SampleTypeOf<std::decay_t<decltype(dsp.flanger)>>::type;
+        dsp.flanger.prepare(numChannels, sampleRate);
+        dsp.effectChain.prepare(static_cast<int>(numChannels), scratchArena);
+        dsp.dryWetMixer.prepare(numChannels, sampleRate);
+        dsp.dryWetMixer.setControlSmoothingTime(jnsc::Time<SampleType>::Milliseconds(50.0f));
+    });
+
+    // Prepare framework parameter smoothing (FloatParams with a smoothing time in Params.h)
+    parameterManager.prepare(sampleRate);
 
     // Initialize DSP with parameter defaults (skip smoothing for instant setup)
     parameterManager.syncAll(true);
 }
 
 void FlangerAudioProcessor::releaseResources() {
-    flanger.reset();
-    dryWetMixer.reset();
-    fxBuffer.resize(0, 0); // Free buffer memory
+    engines.visit([](auto& dsp) {
+        dsp.flanger.reset();
+        dsp.dryWetMixer.reset();
+    });
+    scratchArena.release();
 }
 
 void FlangerAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    process(buffer, midiMessages);
+}
+
+void FlangerAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages) {
+    process(buffer, midiMessages);
+}
+
+bool FlangerAudioProcessor::supportsDoublePrecisionProcessing() const {
+    return true;
+}
+
+template <typename SampleType>
+void FlangerAudioProcessor::process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages) {
     // Get audio buffer info
     const int numInputChannels = getTotalNumInputChannels();
     const int numOutputChannels = getTotalNumOutputChannels();
@@ -80,29 +112,22 @@ void FlangerAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce:
     if (numInputChannels == 0 || numOutputChannels == 0 || numSamples == 0)
         return;
 
-    // Update all parameters from FIFO (GUI thread → Audio thread)
-    parameterManager.update();
-
     // Handle denormals
     juce::ScopedNoDenormals noDenormals;
 
-    // Note: Jonssonic DSP expects numInputChannels == numOutputChannels
-    // So we map the input channels to output channels accordingly
-    jnsc::utils::mapChannels<float>(
-        buffer.getArrayOfReadPointers(), // juce::AudioBuffer<float> uses getArrayOfReadPointers() for const access
-        fxBuffer.writePtrs(),            // jnsc::AudioBuffer<float> uses writePtrs() for non-const access
-        numInputChannels,
-        numOutputChannels,
-        numSamples);
+    // Turn learned MIDI CCs into sample-accurate parameter events
+    parameterManager.processMidi(midiMessages);
 
-    // Process wet signal in fxBuffer
-    flanger.processBlock(fxBuffer.readPtrs(), fxBuffer.writePtrs(), static_cast<size_t>(numSamples));
+    // Process in sub-blocks split at timestamped parameter events (applies pending GUI/host changes first)
+    parameterManager.processSubBlocks(numSamples, [&](int startSample, int numSubSamples) {
+        // View into the host buffer for this sub-block (no copy, no allocation)
+        juce::AudioBuffer<SampleType> block(
+            buffer.getArrayOfWritePointers(), buffer.getNumChannels(), startSample, numSubSamples);
 
-    // Mix wet signal with dry (addFrom adds wet to existing dry signal)
-    dryWetMixer.processBlock(buffer.getArrayOfReadPointers(),  // dry buffer
-                             fxBuffer.readPtrs(),              // wet buffer
-                             buffer.getArrayOfWritePointers(), // final output
-                             static_cast<size_t>(numSamples)); // number of samples
+        // Map inputs to outputs and run the chain in place (effect and mix per cache-sized chunk)
+        engines.get<SampleType>().effectChain.process(
+            block.getArrayOfWritePointers(), numInputChannels, numOutputChannels, numSubSamples);
+    });
 }
 
 void FlangerAudioProcessor::getStateInformation(juce::MemoryBlock& destData) {
@@ -131,14 +156,16 @@ double FlangerAudioProcessor::getTailLengthSeconds() const {
     return 0.0;
 }
 int FlangerAudioProcessor::getNumPrograms() {
-    return 1;
+    return juce::jmax(1, presetLibrary.size()); // Hosts expect at least one program
 }
 int FlangerAudioProcessor::getCurrentProgram() {
-    return 0;
+    return juce::jmax(0, presetLibrary.getCurrentIndex());
+}
+void FlangerAudioProcessor::setCurrentProgram(int index) {
+    presetLibrary.loadPreset(index, parameterManager);
 }
-void FlangerAudioProcessor::setCurrentProgram(int) {}
-const juce::String FlangerAudioProcessor::getProgramName(int) {
-    return {};
+const juce::String FlangerAudioProcessor::getProgramName(int index) {
+    return presetLibrary.getName(index);
 }
 void FlangerAudioProcessor::changeProgramName(int, const juce::String&) {}
 bool FlangerAudioProcessor::hasEditor() const {
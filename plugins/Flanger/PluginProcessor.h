@@ -5,6 +5,9 @@
 #include <jonssonic/core/mixing/dry_wet_mixer.h>
 #include <jonssonic/effects/flanger.h>
 #include <parameters/ParameterManager.h>
+#include <presets/PresetLibrary.h>
+#include <utils/DualPrecision.h>
+#include <utils/ProcessorChain.h>
 
 class FlangerAudioProcessor : public juce::AudioProcessor {
   public:
@@ -13,6 +16,8 @@ class FlangerAudioProcessor : public juce::AudioProcessor {
 
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
     void releaseResources() override;
 
     void getStateInformation(juce::MemoryBlock& destData) override;
@@ -37,13 +42,34 @@ class FlangerAudioProcessor : public juce::AudioProcessor {
     juce::AudioProcessorValueTreeState& getAPVTS() { return parameterManager.getAPVTS(); }
 
   private:
-    // DSP objects
-    jnsc::effects::Flanger<float> flanger;
-    jnsc::AudioBuffer<float> fxBuffer;
-    jnsc::DryWetMixer<float> dryWetMixer;
+    // Process a block in the host's precision (float or double)
+    template <typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
+
+    // Fixed internal block size (the DSP never sees longer blocks, whatever the host sends)
+    static constexpr int internalBlockSize = 64;
+
+    // DSP objects of one sample precision (only the precision the host uses is prepared)
+    template <typename SampleType>
+    struct Engine {
+        jnsc::effects::Flanger<SampleType> flanger;
+        jnsc::DryWetMixer<SampleType> dryWetMixer;
+
+        // Effect chain (runs the flanger and the dry/wet mix chunk by chunk, in place)
+        jnsc::juce_interface::ProcessorChain<jnsc::juce_interface::EffectStage<jnsc::effects::Flanger<SampleType>>,
+                                             jnsc::juce_interface::MixStage<jnsc::DryWetMixer<SampleType>>>
+            effectChain{flanger, dryWetMixer};
+    };
+    jnsc::juce_interface::DualPrecision<Engine> engines; // Float and double DSP
+
+    // Scratch memory shared by the processing stages (sized in prepareToPlay)
+    jnsc::juce_interface::ScratchArena scratchArena;
 
     // Parameter management
     jnsc::juce_interface::ParameterManager<FlangerParams::ID> parameterManager;
 
+    // Preset library (host programs)
+    jnsc::juce_interface::PresetLibrary presetLibrary;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FlangerAudioProcessor)
 };
\ No newline at end of file
@@ -2,9 +2,11 @@
 #include "PluginEditor.h"
 #include <JuceHeader.h>
 #include <iostream>
-#include <jonssonic/utils/buffer_utils.h>
 
-ReverbAudioProcessor::ReverbAudioProcessor() : parameterManager(ReverbParams().createParams(), *this) {
+// Parameter definitions, evaluated at compile time (no heap allocation)
+static constexpr auto parameters = ReverbParams::createParams();
+
+ReverbAudioProcessor::ReverbAudioProcessor() : parameterManager(parameters, *this) {
     // ============================================================================
     // [DEBUG]: Prints all APVTS parameter IDs at startup
     // This helps verify that your parameters are registered correctly.
@@ -18,61 +20,77 @@ ReverbAudioProcessor::ReverbAudioProcessor() : parameterManager(ReverbParams().c
     }
     // ============================================================================
 
+    // Map the preset library; without one the plugin exposes a single default program
+    presetLibrary.open(jnsc::juce_interface::PresetLibrary::getDefaultFile(JucePlugin_Name));
+
     // Register callbacks for parameter changes
     using ID = ReverbParams::ID;
 
     parameterManager.on(ID::PreDelay, [this](float newValue, bool skipSmoothing) {
         // Update Pre-Delay
-        reverb.setPreDelayTimeMs(newValue, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.reverb.setPreDelayTimeMs(newValue, skipSmoothing); });
     });
 
     parameterManager.on(ID::ReverbTimeLow, [this](float newValue, bool skipSmoothing) {
         // Update Reverb Time Low
-        reverb.setReverbTimeLowS(newValue, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.reverb.setReverbTimeLowS(newValue, skipSmoothing); });
     });
 
     parameterManager.on(ID::ReverbTimeHigh, [this](float newValue, bool skipSmoothing) {
         // Update Reverb Time High
-        reverb.setReverbTimeHighS(newValue, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.reverb.setReverbTimeHighS(newValue, skipSmoothing); });
     });
 
     parameterManager.on(ID::Diffusion, [this](float newValue, bool skipSmoothing) {
         // Update Diffusion
-        reverb.setDiffusion(newValue * 0.01, skipSmoothing);
+        engines.visit([&](auto& dsp) { dsp.reverb.setDiffusion(newValue * 0.01, skipSmoothing); });
     });
 
     parameterManager.on(ID::LowCut, [this](float newValue, bool skipSmoothing) {
         // Update Low Cut
-        reverb.setLowCutFreqHz(newValue);
+        engines.visit([&](auto& dsp) { dsp.reverb.setLowCutFreqHz(newValue); });
     });
 
     parameterManager.on(ID::Crossover, [this](float newValue, bool skipSmoothing) {
         // Update Damping Crossover Frequency
-        reverb.setDampingCrossoverFreqHz(newValue);
+        engines.visit([&](auto& dsp) { dsp.reverb.setDampingCrossoverFreqHz(newValue); });
     });
 
     parameterManager.on(ID::ModRate, [this](float newValue, bool skipSmoothing) {
         // Update Modulation Rate
-        reverb.setModulationRateHz(newValue);
+        engines.visit([&](auto& dsp) { dsp.reverb.setModulationRateHz(newValue); });
     });
 
     parameterManager.on(ID::ModDepth, [this](float newValue, bool skipSmoothing) {
         // Update Modulation Depth
-        reverb.setModulationDepth(newValue * 0.01); // Convert percentage to [0.0, 1.0]
+        // Convert percentage to [0.0, 1.0]
+        engines.visit([&](auto& dsp) { dsp.reverb.setModulationDepth(newValue * 0.01); });
     });
     parameterManager.on(ID::Mix, [this](float newValue, bool skipSmoothing) {
-        dryWetMixer.setMix(newValue * 0.01, skipSmoothing); // Convert percentage to [0.0, 1.0]
+        // Convert percentage to [0.0, 1.0]
+        engines.visit([&](auto& dsp) { dsp.dryWetMixer.setMix(newValue * 0.01, skipSmoothing); });
     });
 }
 
 ReverbAudioProcessor::~ReverbAudioProcessor() {}
 
 void ReverbAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
+    // Process in fixed internal blocks for consistent cache use with any host block size
+    parameterManager.setMaxSubBlockSize(internalBlockSize);
+
+    // Run the DSP natively in the precision the host processes in
+    engines.setDoublePrecision(isUsingDoublePrecision());
+
     auto numChannels = static_cast<size_t>(getTotalNumOutputChannels());
     // Prepare all DSP objects and buffers here
-    reverb.prepare(numChannels, static_cast<float>(sampleRate));
-    dryWetMixer.prepare(numChannels, static_cast<float>(sampleRate));
-    fxBuffer.setSize(static_cast<int>(numChannels), samplesPerBlock);
+    engines.visit([&](auto& dsp) {
+        dsp.reverb.prepare(numChannels, static_cast<float>(sampleRate));
+        dsp.dryWetMixer.prepare(numChannels, static_cast<float>(sampleRate));
+        dsp.effectChain.prepare(static_cast<int>(numChannels), scratchArena);
+    });
+
+    // Prepare framework parameter smoothing (FloatParams with a smoothing time in Params.h)
+    parameterManager.prepare(sampleRate);
 
     // Initialize DSP with parameter defaults (defined in Params.h) (skip smoothing for instant setup)
     parameterManager.syncAll(true);
@@ -80,12 +98,27 @@ void ReverbAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 
 void ReverbAudioProcessor::releaseResources() {
     // Release DSP resources here
-    reverb.reset();
-    dryWetMixer.reset();
-    fxBuffer.setSize(0, 0);
+    engines.visit([](auto& dsp) {
+        dsp.reverb.reset();
+        dsp.dryWetMixer.reset();
+    });
+    scratchArena.release();
 }
 
 void ReverbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    process(buffer, midiMessages);
+}
+
+void ReverbAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages) {
+    process(buffer, midiMessages);
+}
+
+bool ReverbAudioProcessor::supportsDoublePrecisionProcessing() const {
+    return true;
+}
+
+template <typename SampleType>
+void ReverbAudioProcessor::process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages) {
     // Get audio buffer info
     const int numInputChannels = getTotalNumInputChannels();
     const int numOutputChannels = getTotalNumOutputChannels();
@@ -94,30 +127,23 @@ void ReverbAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::
     // Early return if no audio to process
     if (numInputChannels == 0 || numOutputChannels == 0 || numSamples == 0)
         return;
-    // Update all parameters from FIFO (GUI thread → Audio thread)
-    parameterManager.update();
 
     // Handle denormals
     juce::ScopedNoDenormals noDenormals;
 
-    // Note: Jonssonic DSP expects numInputChannels == numOutputChannels
-    // So we map the input channels to output channels accordingly
-    jnsc::utils::mapChannels<float>(buffer.getArrayOfReadPointers(),
-                                    fxBuffer.getArrayOfWritePointers(),
-                                    numInputChannels,
-                                    numOutputChannels,
-                                    numSamples);
+    // Turn learned MIDI CCs into sample-accurate parameter events
+    parameterManager.processMidi(midiMessages);
 
-    // Process Reverb
-    reverb.processBlock(fxBuffer.getArrayOfReadPointers(),  // input
-                        fxBuffer.getArrayOfWritePointers(), // output
-                        static_cast<size_t>(numSamples));   // number of samples
+    // Process in sub-blocks split at timestamped parameter events (applies pending GUI/host changes first)
+    parameterManager.processSubBlocks(numSamples, [&](int startSample, int numSubSamples) {
+        // View into the host buffer for this sub-block (no copy, no allocation)
+        juce::AudioBuffer<SampleType> block(
+            buffer.getArrayOfWritePointers(), buffer.getNumChannels(), startSample, numSubSamples);
 
-    // Process Dry/Wet
-    dryWetMixer.processBlock(buffer.getArrayOfReadPointers(),   // dry input
-                             fxBuffer.getArrayOfReadPointers(), // wet input
-                             buffer.getArrayOfWritePointers(),  // output
-                             static_cast<size_t>(numSamples));  // number of samples
+        // Map inputs to outputs and run the chain in place (effect and mix per cache-sized chunk)
+        engines.get<SampleType>().effectChain.process(
+            block.getArrayOfWritePointers(), numInputChannels, numOutputChannels, numSubSamples);
+    });
 }
 
 void ReverbAudioProcessor::getStateInformation(juce::MemoryBlock& destData) {
@@ -148,14 +174,16 @@ double ReverbAudioProcessor::getTailLengthSeconds() const {
     return 0.0;
 }
 int ReverbAudioProcessor::getNumPrograms() {
-    return 1;
+    return juce::jmax(1, presetLibrary.size()); // Hosts expect at least one program
 }
 int ReverbAudioProcessor::getCurrentProgram() {
-    return 0;
+    return juce::jmax(0, presetLibrary.getCurrentIndex());
+}
+void ReverbAudioProcessor::setCurrentProgram(int index) {
+    presetLibrary.loadPreset(index, parameterManager);
 }
-void ReverbAudioProcessor::setCurrentProgram(int) {}
-const juce::String ReverbAudioProcessor::getProgramName(int) {
-    return {};
+const juce::String ReverbAudioProcessor::getProgramName(int index) {
+    return presetLibrary.getName(index);
 }
 void ReverbAudioProcessor::changeProgramName(int, const juce::String&) {}
 bool ReverbAudioProcessor::hasEditor() const {
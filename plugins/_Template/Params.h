@@ -14,13 +14,13 @@ struct TemplateParams {
     enum class ID { Mix, Enable, Mode };
 
     // Create parameter definitions
-    inline jnsc::juce_interface::ParameterSet<ID> createParams() {
+    static constexpr jnsc::juce_interface::ParameterSet<ID> createParams() {
         using namespace jnsc::juce_interface;
 
         ParameterSet<ID> params;
         // clang-format off
-        // Float parameter        ↓ id          ↓ name      ↓ min   ↓ max     ↓ def     ↓ unit  ↓ skew
-        params.add(FloatParam<ID>{ID::Mix,      "Mix",      0.0f,   100.0f,   50.0f,    "%",    1.0f});
+        // Float parameter        ↓ id          ↓ name      ↓ min   ↓ max     ↓ def     ↓ unit  ↓ skew  ↓ smoothing ms
+        params.add(FloatParam<ID>{ID::Mix,      "Mix",      0.0f,   100.0f,   50.0f,    "%",    1.0f,   20.0f});
 
         // Bool parameter        ↓ id           ↓ name      ↓ def    ↓ true label   ↓ false label
         params.add(BoolParam<ID>{ID::Enable,    "Enable",   false,    "On",         "Off"});
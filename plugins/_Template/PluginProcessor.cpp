@@ -1,9 +1,11 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 #include <iostream>
-#include <jonssonic/utils/buffer_utils.h>
 
-TemplateAudioProcessor::TemplateAudioProcessor() : parameterManager(TemplateParams().createParams(), *this) {
+// Parameter definitions, evaluated at compile time (no heap allocation)
+static constexpr auto parameters = TemplateParams::createParams();
+
+TemplateAudioProcessor::TemplateAudioProcessor() : parameterManager(parameters, *this) {
     // ============================================================================
     // [DEBUG]: Prints all APVTS parameter IDs at startup
     // This helps verify that your parameters are registered correctly.
@@ -17,13 +19,17 @@ TemplateAudioProcessor::TemplateAudioProcessor() : parameterManager(TemplatePara
     }
     // ============================================================================
 
+    // Map the preset library; without one the plugin exposes a single default program
+    presetLibrary.open(jnsc::juce_interface::PresetLibrary::getDefaultFile(JucePlugin_Name));
+
     // Register callbacks for parameter changes
     using ID = TemplateParams::ID;
 
-    parameterManager.on(ID::Mix, [this](float value, bool skipSmoothing) {
-        DBG("[DEBUG] Mix changed: " + juce::String(value) + ", skipSmoothing: " + (skipSmoothing ? "true" : "false"));
+    // Smoothed by the framework: called every sub-block while ramping, so no logging here
+    parameterManager.on(ID::Mix, [this](float value, bool /*skipSmoothing*/) {
         // Call your DSP mix setter here
-        dryWetMixer.setMix(value * 0.01f); // We are converting from [0,100] to [0,1]
+        // We are converting from [0,100] to [0,1]
+        engines.visit([&](auto& dsp) { dsp.dryWetMixer.setMix(value * 0.01f); });
     });
     parameterManager.on(ID::Enable, [this](bool value, bool skipSmoothing) {
         DBG("[DEBUG] Enable changed: " + juce::String(value ? "true" : "false") +
@@ -39,10 +45,21 @@ TemplateAudioProcessor::TemplateAudioProcessor() : parameterManager(TemplatePara
 TemplateAudioProcessor::~TemplateAudioProcessor() {}
 
 void TemplateAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
+    // Process in fixed internal blocks for consistent cache use with any host block size
+    parameterManager.setMaxSubBlockSize(internalBlockSize);
+
+    // Run the DSP natively in the precision the host processes in
+    engines.setDoublePrecision(isUsingDoublePrecision());
+
     auto numChannels = static_cast<size_t>(getTotalNumOutputChannels());
     // Prepare all DSP objects and buffers here
-    dryWetMixer.prepare(numChannels, static_cast<float>(sampleRate));
-    fxBuffer.resize(numChannels, static_cast<size_t>(samplesPerBlock));
+    engines.visit([&](auto& dsp) {
+        dsp.dryWetMixer.prepare(numChannels, static_cast<float>(sampleRate));
+        dsp.effectChain.prepare(static_cast<int>(numChannels), scratchArena);
+    });
+
+    // Prepare framework parameter smoothing (FloatParams with a smoothing time in Params.h)
+    parameterManager.prepare(sampleRate);
 
     // Initialize DSP with parameter defaults (defined in Params.h) (skip smoothing for instant setup)
     parameterManager.syncAll(true);
@@ -50,11 +67,24 @@ void TemplateAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBloc
 
 void TemplateAudioProcessor::releaseResources() {
     // Release DSP resources here
-    dryWetMixer.reset();
-    fxBuffer.resize(0, 0);
+    engines.visit([](auto& dsp) { dsp.dryWetMixer.reset(); });
+    scratchArena.release();
 }
 
 void TemplateAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    process(buffer, midiMessages);
+}
+
+void TemplateAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages) {
+    process(buffer, midiMessages);
+}
+
+bool TemplateAudioProcessor::supportsDoublePrecisionProcessing() const {
+    return true;
+}
+
+template <typename SampleType>
+void TemplateAudioProcessor::process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages) {
     // Get audio buffer info
     const int numInputChannels = getTotalNumInputChannels();
     const int numOutputChannels = getTotalNumOutputChannels();
@@ -63,26 +93,23 @@ void TemplateAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
     // Early return if no audio to process
     if (numInputChannels == 0 || numOutputChannels == 0 || numSamples == 0)
         return;
-    // Update all parameters from FIFO (GUI thread → Audio thread)
-    parameterManager.update();
 
     // Handle denormals
     juce::ScopedNoDenormals noDenormals;
 
-    // Note: Jonssonic DSP expects numInputChannels == numOutputChannels
-    // So we map the input channels to output channels accordingly
-    jnsc::utils::mapChannels<float>(
-        buffer.getArrayOfReadPointers(), // juce::AudioBuffer<float> uses getArrayOfReadPointers() for const access
-        fxBuffer.writePtrs(),            // Jonssonic::AudioBuffer<float> uses writePtrs() for non-const access
-        numInputChannels,
-        numOutputChannels,
-        numSamples);
+    // Turn learned MIDI CCs into sample-accurate parameter events
+    parameterManager.processMidi(midiMessages);
+
+    // Process in sub-blocks split at timestamped parameter events (applies pending GUI/host changes first)
+    parameterManager.processSubBlocks(numSamples, [&](int startSample, int numSubSamples) {
+        // View into the host buffer for this sub-block (no copy, no allocation)
+        juce::AudioBuffer<SampleType> block(
+            buffer.getArrayOfWritePointers(), buffer.getNumChannels(), startSample, numSubSamples);
 
-    // DSP processing here (this template includes only a dry/wet mixer as an example)
-    dryWetMixer.processBlock(buffer.getArrayOfReadPointers(),  // dry buffer
-                             fxBuffer.readPtrs(),              // wet buffer
-                             buffer.getArrayOfWritePointers(), // final output
-                             static_cast<size_t>(numSamples)); // number of samples
+        // Map inputs to outputs and run the chain in place (effect and mix per cache-sized chunk)
+        engines.get<SampleType>().effectChain.process(
+            block.getArrayOfWritePointers(), numInputChannels, numOutputChannels, numSubSamples);
+    });
 }
 
 void TemplateAudioProcessor::getStateInformation(juce::MemoryBlock& destData) {
@@ -113,14 +140,16 @@ double TemplateAudioProcessor::getTailLengthSeconds() const {
     return 0.0;
 }
 int TemplateAudioProcessor::getNumPrograms() {
-    return 1;
+    return juce::jmax(1, presetLibrary.size()); // Hosts expect at least one program
 }
 int TemplateAudioProcessor::getCurrentProgram() {
-    return 0;
+    return juce::jmax(0, presetLibrary.getCurrentIndex());
+}
+void TemplateAudioProcessor::setCurrentProgram(int index) {
+    presetLibrary.loadPreset(index, parameterManager);
 }
-void TemplateAudioProcessor::setCurrentProgram(int) {}
-const juce::String TemplateAudioProcessor::getProgramName(int) {
-    return {};
+const juce::String TemplateAudioProcessor::getProgramName(int index) {
+    return presetLibrary.getName(index);
 }
 void TemplateAudioProcessor::changeProgramName(int, const juce::String&) {}
 bool TemplateAudioProcessor::hasEditor() const {
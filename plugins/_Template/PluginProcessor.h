@@ -5,6 +5,9 @@
 #include <jonssonic/core/common/audio_buffer.h>
 #include <jonssonic/core/mixing/dry_wet_mixer.h>
 #include <parameters/ParameterManager.h>
+#include <presets/PresetLibrary.h>
+#include <utils/DualPrecision.h>
+#include <utils/ProcessorChain.h>
 
 class TemplateAudioProcessor : public juce::AudioProcessor {
   public:
@@ -13,6 +16,8 @@ class TemplateAudioProcessor : public juce::AudioProcessor {
 
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override;
     void releaseResources() override;
 
     void getStateInformation(juce::MemoryBlock& destData) override;
@@ -37,11 +42,31 @@ class TemplateAudioProcessor : public juce::AudioProcessor {
     juce::AudioProcessorValueTreeState& getAPVTS() { return parameterManager.getAPVTS(); }
 
   private:
-    // DSP objects and buffers
-    jnsc::AudioBuffer<float> fxBuffer;    // Buffer for effect processing
-    jnsc::DryWetMixer<float> dryWetMixer; // Dry/wet mixer
+    // Process a block in the host's precision (float or double)
+    template <typename SampleType>
+    void process(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
+
+    // Fixed internal block size (the DSP never sees longer blocks, whatever the host sends)
+    static constexpr int internalBlockSize = 64;
+
+    // DSP objects of one sample precision (only the precision the host uses is prepared)
+    template <typename SampleType>
+    struct Engine {
+        jnsc::DryWetMixer<SampleType> dryWetMixer; // Dry/wet mixer
+
+        // Effect chain (add EffectStage<...> entries before the mix stage for your DSP)
+        jnsc::juce_interface::ProcessorChain<jnsc::juce_interface::MixStage<jnsc::DryWetMixer<SampleType>>> effectChain{
+            dryWetMixer};
+    };
+    jnsc::juce_interface::DualPrecision<Engine> engines; // Float and double DSP
+
+    // Scratch memory shared by the processing stages (sized in prepareToPlay)
+    jnsc::juce_interface::ScratchArena scratchArena;
 
     // Parameter manager
     jnsc::juce_interface::ParameterManager<TemplateParams::ID> parameterManager;
+
+    // Preset library (host programs)
+    jnsc::juce_interface::PresetLibrary presetLibrary;
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TemplateAudioProcessor)
 };
\ No newline at end of file
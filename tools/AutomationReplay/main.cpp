@@ -0,0 +1,122 @@
+// Jonssonic Plugin Framework
+// Automation replay - drives a plugin processor with a captured automation session
+// SPDX-License-Identifier: MIT
+
+#include "PluginProcessor.h"
+#include <parameters/AutomationPlayer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+namespace {
+
+using namespace jnsc::juce_interface;
+
+constexpr int fallbackBlockSize = 512;         // Used for blocks whose length was not recorded
+constexpr double fallbackSampleRate = 48000.0; // Used if the capture has no sample rate
+
+// Per-block timing of a replay
+struct ReplayStats {
+    double totalSeconds = 0.0;
+    double slowestSeconds = 0.0;
+    size_t slowestBlock = 0;
+    int64_t numSamples = 0;
+};
+
+// Replay every recorded block: feed its events, then process it with its recorded length
+template <typename SampleType>
+ReplayStats replay(DistortionAudioProcessor& processor, const AutomationPlayer& player, int numChannels) {
+    const int maxBlockSize = player.getMaxBlockSize(fallbackBlockSize);
+    juce::AudioBuffer<SampleType> buffer(numChannels, maxBlockSize);
+    juce::MidiBuffer midi; // Recorded MIDI CC is replayed as timestamped events
+
+    // White noise keeps the signal far from denormals
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+
+    ReplayStats stats;
+    for (size_t block = 0; block < player.getNumBlocks(); ++block) {
+        const int numSamples = player.getBlockSize(block, fallbackBlockSize);
+        buffer.setSize(numChannels, numSamples, false, false, true);
+        for (int ch = 0; ch < numChannels; ++ch) {
+            auto* channel = buffer.getWritePointer(ch);
+            for (int i = 0; i < numSamples; ++i)
+                channel[i] = static_cast<SampleType>(noise(rng));
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        player.applyBlock(block, processor.getParameterManager());
+        processor.processBlock(buffer, midi);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        stats.totalSeconds += elapsed.count();
+        stats.numSamples += numSamples;
+        if (elapsed.count() > stats.slowestSeconds) {
+            stats.slowestSeconds = elapsed.count();
+            stats.slowestBlock = block;
+        }
+    }
+    return stats;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: AutomationReplay <capture file> [--double]\n");
+        return 1;
+    }
+
+    // The processor's timers and async updates need a message manager
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    AutomationPlayer player;
+    const auto captureFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[1]);
+    if (!player.load(captureFile)) {
+        std::fprintf(stderr, "Could not load capture: %s\n", captureFile.getFullPathName().toRawUTF8());
+        return 1;
+    }
+
+    DistortionAudioProcessor processor;
+    const bool useDouble = argc > 2 && std::strcmp(argv[2], "--double") == 0;
+    if (useDouble && !processor.supportsDoublePrecisionProcessing()) {
+        std::fprintf(stderr, "The processor does not support double precision\n");
+        return 1;
+    }
+
+    const double sampleRate = player.getSampleRate() > 0.0 ? player.getSampleRate() : fallbackSampleRate;
+    const int maxBlockSize = player.getMaxBlockSize(fallbackBlockSize);
+    const int numChannels =
+        std::max(1, std::max(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels()));
+
+    processor.setProcessingPrecision(useDouble ? juce::AudioProcessor::doublePrecision
+                                               : juce::AudioProcessor::singlePrecision);
+    processor.setRateAndBufferSizeDetails(sampleRate, maxBlockSize);
+    processor.prepareToPlay(sampleRate, maxBlockSize);
+
+    const auto stats = useDouble ? replay<double>(processor, player, numChannels)
+                                 : replay<float>(processor, player, numChannels);
+    processor.releaseResources();
+
+    const double audioSeconds = static_cast<double>(stats.numSamples) / sampleRate;
+    std::printf("%s: %zu blocks, %.1f s of audio at %.0f Hz (%s)\n",
+                processor.getName().toRawUTF8(),
+                player.getNumBlocks(),
+                audioSeconds,
+                sampleRate,
+                useDouble ? "double" : "float");
+    if (stats.numSamples == 0)
+        return 0;
+
+    std::printf("total          %10.3f ms %9.1fx real time\n",
+                stats.totalSeconds * 1.0e3,
+                audioSeconds / stats.totalSeconds);
+    std::printf("slowest block  %10.3f ms (block %zu, %d samples)\n",
+                stats.slowestSeconds * 1.0e3,
+                stats.slowestBlock,
+                player.getBlockSize(stats.slowestBlock, fallbackBlockSize));
+    return 0;
+}
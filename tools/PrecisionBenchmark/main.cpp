@@ -0,0 +1,158 @@
+// Jonssonic Plugin Framework
+// Precision benchmark - times the float and double processing paths of a plugin engine
+// SPDX-License-Identifier: MIT
+
+#include <jonssonic/core/mixing/dry_wet_mixer.h>
+#include <jonssonic/effects/chorus.h>
+#include <utils/ProcessorChain.h>
+#include <utils/ScratchArena.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace jnsc::juce_interface;
+
+constexpr double sampleRate = 48000.0;
+constexpr int numChannels = 2;
+constexpr int hostBlockSize = 512;
+constexpr int internalBlockSize = 64; // Chunk length the plugins process in
+constexpr int numBlocks = 4000;       // About 43 s of audio per run
+constexpr int numRuns = 5;            // The fastest run is reported
+
+// Same DSP and effect chain as the Chorus plugin engine
+template <typename SampleType>
+struct Engine {
+    jnsc::effects::Chorus<SampleType> chorus;
+    jnsc::DryWetMixer<SampleType> dryWetMixer;
+    ProcessorChain<EffectStage<jnsc::effects::Chorus<SampleType>>, MixStage<jnsc::DryWetMixer<SampleType>>>
+        effectChain{chorus, dryWetMixer};
+
+    void prepare(ScratchArena& arena) {
+        chorus.prepare(static_cast<size_t>(numChannels), static_cast<float>(sampleRate));
+        dryWetMixer.prepare(static_cast<size_t>(numChannels), static_cast<float>(sampleRate));
+        effectChain.prepare(numChannels, arena);
+
+        // Chorus plugin defaults
+        chorus.setRate(1.0f, true);
+        chorus.setDepth(0.5f, true);
+        chorus.setSpread(0.0f, true);
+        chorus.setDelayMs(20.0f, true);
+        chorus.setFeedback(0.0f, true);
+        dryWetMixer.setMix(0.5f);
+    }
+
+    // Process a host block in place, in internal chunks like ParameterManager::processSubBlocks()
+    void process(SampleType* const* channels, int numSamples) {
+        std::array<SampleType*, numChannels> chunk{};
+        for (int start = 0; start < numSamples; start += internalBlockSize) {
+            const int length = std::min(internalBlockSize, numSamples - start);
+            for (int ch = 0; ch < numChannels; ++ch)
+                chunk[static_cast<size_t>(ch)] = channels[ch] + start;
+            effectChain.process(chunk.data(), numChannels, numChannels, length);
+        }
+    }
+};
+
+// Host buffer of one precision
+template <typename SampleType>
+struct HostBuffer {
+    HostBuffer() {
+        for (int ch = 0; ch < numChannels; ++ch)
+            pointers[static_cast<size_t>(ch)] = data[static_cast<size_t>(ch)].data();
+    }
+
+    // Refill from the source signal (processing is in place)
+    void load(const std::vector<float>& source) {
+        for (auto& channel : data)
+            std::copy(source.begin(), source.end(), channel.begin());
+    }
+
+    std::array<std::array<SampleType, hostBlockSize>, numChannels> data{};
+    std::array<SampleType*, numChannels> pointers{};
+};
+
+// Wall time of the fastest of numRuns runs, in seconds
+template <typename RunFn>
+double timeFastestRun(RunFn&& run) {
+    double fastest = 0.0;
+    for (int i = 0; i < numRuns; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        fastest = i == 0 ? elapsed.count() : std::min(fastest, elapsed.count());
+    }
+    return fastest;
+}
+
+void report(const char* name, double seconds) {
+    const double numSamples = static_cast<double>(numBlocks) * hostBlockSize;
+    std::printf("%-34s %8.2f ns/sample %9.1fx real time\n",
+                name,
+                seconds * 1.0e9 / numSamples,
+                numSamples / sampleRate / seconds);
+}
+
+} // namespace
+
+int main() {
+    // White noise keeps the signal far from denormals
+    std::vector<float> source(hostBlockSize);
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    for (auto& sample : source)
+        sample = noise(rng);
+
+    ScratchArena scratchArena;
+    Engine<float> floatEngine;
+    Engine<double> doubleEngine;
+    floatEngine.prepare(scratchArena);
+    doubleEngine.prepare(scratchArena);
+
+    std::printf("Chorus engine, %d channels, %d-sample host blocks, %d-sample chunks, %.0f Hz\n",
+                numChannels,
+                hostBlockSize,
+                internalBlockSize,
+                sampleRate);
+
+    // Float host, float DSP
+    HostBuffer<float> floatBuffer;
+    report("float", timeFastestRun([&] {
+               for (int b = 0; b < numBlocks; ++b) {
+                   floatBuffer.load(source);
+                   floatEngine.process(floatBuffer.pointers.data(), hostBlockSize);
+               }
+           }));
+
+    // Double host, double DSP (supportsDoublePrecisionProcessing() == true)
+    HostBuffer<double> doubleBuffer;
+    report("double (native)", timeFastestRun([&] {
+               for (int b = 0; b < numBlocks; ++b) {
+                   doubleBuffer.load(source);
+                   doubleEngine.process(doubleBuffer.pointers.data(), hostBlockSize);
+               }
+           }));
+
+    // Double host, float DSP: the wrapper converts every block to float and back
+    report("double (converted to float)", timeFastestRun([&] {
+               for (int b = 0; b < numBlocks; ++b) {
+                   doubleBuffer.load(source);
+                   for (int ch = 0; ch < numChannels; ++ch) {
+                       const auto c = static_cast<size_t>(ch);
+                       std::copy(doubleBuffer.data[c].begin(), doubleBuffer.data[c].end(), floatBuffer.data[c].begin());
+                   }
+                   floatEngine.process(floatBuffer.pointers.data(), hostBlockSize);
+                   for (int ch = 0; ch < numChannels; ++ch) {
+                       const auto c = static_cast<size_t>(ch);
+                       std::copy(floatBuffer.data[c].begin(), floatBuffer.data[c].end(), doubleBuffer.data[c].begin());
+                   }
+               }
+           }));
+
+    return 0;
+}